@@ -0,0 +1,104 @@
+#include <azul/async/Expected.hpp>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+namespace
+{
+    enum class LookupError
+    {
+        NotFound
+    };
+
+    using Result = azul::async::Expected<int, LookupError>;
+
+    constexpr int Iterations = 100000;
+    constexpr int ChainLength = 4;
+
+    // keeps the results observable so the loops are not optimized away
+    volatile long Sink = 0;
+
+    template <typename F>
+    double MeasureNanoseconds(F&& iteration)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        for (int i = 0; i < Iterations; ++i)
+        {
+            iteration(i);
+        }
+        auto const duration = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(duration).count() / Iterations;
+    }
+
+    // error set on a promise and propagated through a chain of continuations
+    double ExceptionChain()
+    {
+        return MeasureNanoseconds([](int i) {
+            azul::async::Promise<int> promise;
+            auto future = promise.GetFuture();
+            for (int j = 0; j < ChainLength; ++j)
+            {
+                future = future.Then([](azul::async::Future<int> f) { return f.Get() + 1; });
+            }
+            promise.SetException(std::make_exception_ptr(std::runtime_error("not found")));
+            try
+            {
+                Sink += future.Get();
+            }
+            catch (std::runtime_error const&)
+            {
+                Sink += i;
+            }
+        });
+    }
+
+    double ExpectedChain()
+    {
+        return MeasureNanoseconds([](int i) {
+            azul::async::Promise<Result> promise;
+            auto future = promise.GetFuture();
+            for (int j = 0; j < ChainLength; ++j)
+            {
+                future = azul::async::ThenValue(future, [](int value) { return value + 1; });
+            }
+            promise.SetValue(Result(azul::async::MakeUnexpected(LookupError::NotFound)));
+            auto value = future.Get();
+            Sink += value ? value.Value() : i;
+        });
+    }
+
+    // error reported by an already completed future
+    double ExceptionReady()
+    {
+        return MeasureNanoseconds([](int i) {
+            auto future = azul::async::MakeExceptionalFuture<int>(std::runtime_error("not found"));
+            try
+            {
+                Sink += future.Get();
+            }
+            catch (std::runtime_error const&)
+            {
+                Sink += i;
+            }
+        });
+    }
+
+    double ExpectedReady()
+    {
+        return MeasureNanoseconds([](int i) {
+            auto future = azul::async::MakeReadyFuture(Result(azul::async::MakeUnexpected(LookupError::NotFound)));
+            auto value = future.Get();
+            Sink += value ? value.Value() : i;
+        });
+    }
+}
+
+int main()
+{
+    std::printf("error path, %d iterations, chain length %d\n", Iterations, ChainLength);
+    std::printf("exception chain:  %.1f ns\n", ExceptionChain());
+    std::printf("expected chain:   %.1f ns\n", ExpectedChain());
+    std::printf("exception ready:  %.1f ns\n", ExceptionReady());
+    std::printf("expected ready:   %.1f ns\n", ExpectedReady());
+    return 0;
+}
@@ -0,0 +1,81 @@
+#if defined(__linux__)
+
+#include <azul/async/File.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t BlockSize = 64 * 1024;
+    constexpr std::size_t Blocks = 512;
+    constexpr std::size_t BlocksInFlight = 32;
+
+    // reads the whole file with a fixed number of reads in flight, returns MiB/s
+    double ReadThroughput(azul::async::IoServiceOptions const& options, char const* path)
+    {
+        auto service = std::make_shared<azul::async::IoService>(nullptr, options);
+        auto file = azul::async::File::Open(service, path, O_RDONLY);
+
+        std::vector<char> buffer(BlocksInFlight * BlockSize);
+        std::vector<azul::async::Future<std::size_t>> reads(BlocksInFlight);
+
+        auto const start = Clock::now();
+        for (std::size_t block = 0; block < Blocks; ++block)
+        {
+            auto const slot = block % BlocksInFlight;
+            if (reads[slot].Valid())
+            {
+                reads[slot].Get();
+            }
+            reads[slot] = file.ReadAt(buffer.data() + slot * BlockSize, BlockSize, block * BlockSize);
+        }
+        for (auto& read : reads)
+        {
+            read.Get();
+        }
+        auto const seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        return static_cast<double>(Blocks * BlockSize) / (1024.0 * 1024.0) / seconds;
+    }
+}
+
+int main()
+{
+    char path[] = "/tmp/azul_file_benchmark_XXXXXX";
+    auto const fd = ::mkstemp(path);
+    std::vector<char> block(BlockSize, 'x');
+    for (std::size_t i = 0; i < Blocks; ++i)
+    {
+        if (::write(fd, block.data(), block.size()) != static_cast<ssize_t>(block.size()))
+        {
+            return 1;
+        }
+    }
+    ::close(fd);
+
+    azul::async::IoServiceOptions uring;
+    azul::async::IoServiceOptions blocking;
+    blocking.preferIoUring = false;
+
+    // the file is in the page cache after writing it, this measures the submission overhead and not the device
+    std::printf("read io_uring: %.0f MiB/s\n", ReadThroughput(uring, path));
+    std::printf("read blocking: %.0f MiB/s\n", ReadThroughput(blocking, path));
+
+    ::unlink(path);
+    return 0;
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <atomic>
+#include <azul/async/SpinningExecutor.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int HandoffIterations = 2000;
+
+    // median time between submitting a task and the task starting on a thread of the executor
+    template <typename TExecutor>
+    double MedianHandoffNanoseconds(TExecutor& executor)
+    {
+        std::vector<double> samples;
+        samples.reserve(HandoffIterations);
+
+        for (int i = 0; i < HandoffIterations; ++i)
+        {
+            std::atomic<bool> started{ false };
+            Clock::time_point startedAt;
+
+            auto const submittedAt = Clock::now();
+            executor.Execute([&started, &startedAt]() {
+                startedAt = Clock::now();
+                started.store(true, std::memory_order_release);
+            });
+
+            // yields (instead of spinning as well) so that the measurement also works with few cores
+            while (!started.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            samples.push_back(std::chrono::duration<double, std::nano>(startedAt - submittedAt).count());
+
+            // lets the pool threads go back to sleep, which is the common case for sporadic market data
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+
+        std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+        return samples[samples.size() / 2];
+    }
+}
+
+int main()
+{
+    {
+        azul::async::StaticThreadPool threadPool(1);
+        std::printf("handoff static thread pool: %.0f ns (median)\n", MedianHandoffNanoseconds(threadPool));
+    }
+    {
+        azul::async::SpinningExecutor executor(1);
+        std::printf("handoff spinning executor:  %.0f ns (median)\n", MedianHandoffNanoseconds(executor));
+    }
+    return 0;
+}
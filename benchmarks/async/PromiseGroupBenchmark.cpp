@@ -0,0 +1,75 @@
+#include <azul/async/Executor.hpp>
+#include <azul/async/Future.hpp>
+#include <azul/async/PromiseGroup.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int Iterations = 2000;
+    constexpr int BatchSize = 64;
+
+    // every promise of the batch has a continuation which runs on the executor
+    double CompleteIndividually(std::shared_ptr<azul::async::Executor> const& executor)
+    {
+        auto const start = Clock::now();
+        for (int i = 0; i < Iterations; ++i)
+        {
+            std::vector<azul::async::Promise<int>> promises(BatchSize);
+            std::vector<azul::async::Future<int>> results;
+            for (auto& promise : promises)
+            {
+                results.emplace_back(promise.GetFuture().Then(executor, [](azul::async::Future<int> value) { return value.Get() + 1; }));
+            }
+
+            for (auto& promise : promises)
+            {
+                promise.SetValue(i);
+            }
+            for (auto& result : results)
+            {
+                result.Get();
+            }
+        }
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / Iterations;
+    }
+
+    double CompleteAsGroup(std::shared_ptr<azul::async::Executor> const& executor)
+    {
+        std::vector<int> values(BatchSize);
+
+        auto const start = Clock::now();
+        for (int i = 0; i < Iterations; ++i)
+        {
+            azul::async::PromiseGroup<int> group(BatchSize, executor);
+            std::vector<azul::async::Future<int>> results;
+            for (int j = 0; j < BatchSize; ++j)
+            {
+                results.emplace_back(group.GetFuture(j).Then([](azul::async::Future<int> value) { return value.Get() + 1; }));
+            }
+
+            std::fill(values.begin(), values.end(), i);
+            group.SetValues(values);
+            for (auto& result : results)
+            {
+                result.Get();
+            }
+        }
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / Iterations;
+    }
+}
+
+int main()
+{
+    auto const executor = azul::async::MakeExecutor(std::make_shared<azul::async::StaticThreadPool>(2));
+
+    std::printf("complete %d promises individually: %.2f us\n", BatchSize, CompleteIndividually(executor));
+    std::printf("complete %d promises as group:     %.2f us\n", BatchSize, CompleteAsGroup(executor));
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <azul/async/StaticThreadPool.hpp>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int Iterations = 200;
+    constexpr int TasksPerIteration = 1000;
+
+    // cost of submitting and running tiny tasks, compare builds with and without LIBAZUL_WITH_ASYNC_METRICS
+    double SubmitAndWait(azul::async::StaticThreadPool& threadPool)
+    {
+        std::vector<azul::async::Future<int>> futures;
+        futures.reserve(TasksPerIteration);
+
+        auto const start = Clock::now();
+        for (int i = 0; i < Iterations; ++i)
+        {
+            futures.clear();
+            for (int j = 0; j < TasksPerIteration; ++j)
+            {
+                futures.emplace_back(threadPool.Execute([j]() { return j; }));
+            }
+            for (auto& future : futures)
+            {
+                future.Wait();
+            }
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (Iterations * TasksPerIteration);
+    }
+}
+
+int main()
+{
+    azul::async::StaticThreadPool threadPool(2);
+
+    auto const perTask = SubmitAndWait(threadPool);
+    auto const metrics = threadPool.Metrics();
+
+    std::printf("metrics %s: %.1f ns per task\n", metrics.enabled ? "enabled" : "compiled out", perTask);
+    if (metrics.enabled)
+    {
+        std::printf("wait p50 %llu ns, p99 %llu ns, run p50 %llu ns\n",
+            static_cast<unsigned long long>(metrics.waitTime.Percentile(50)),
+            static_cast<unsigned long long>(metrics.waitTime.Percentile(99)),
+            static_cast<unsigned long long>(metrics.runTime.Percentile(50)));
+        for (std::size_t i = 0; i < metrics.workers.size(); ++i)
+        {
+            std::printf("worker %zu: %llu tasks, %.1f%% busy, %llu parks\n", i,
+                static_cast<unsigned long long>(metrics.workers[i].executedTasks),
+                metrics.workers[i].Utilization() * 100.0,
+                static_cast<unsigned long long>(metrics.workers[i].parks));
+        }
+    }
+    return 0;
+}
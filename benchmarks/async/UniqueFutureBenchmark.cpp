@@ -0,0 +1,60 @@
+#include <azul/async/Future.hpp>
+#include <azul/async/UniqueFuture.hpp>
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int Iterations = 200000;
+    constexpr int ChainLength = 4;
+
+    // one producer, one consumer: a promise, a short chain of continuations and a blocking Get
+    double SharedFutures()
+    {
+        long long sum = 0;
+        auto const start = Clock::now();
+        for (int i = 0; i < Iterations; ++i)
+        {
+            azul::async::Promise<int> promise;
+            auto future = promise.GetFuture();
+            for (int j = 0; j < ChainLength; ++j)
+            {
+                future = future.Then([](azul::async::Future<int> value) { return value.Get() + 1; });
+            }
+
+            promise.SetValue(i);
+            sum += future.Get();
+        }
+        auto const elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / Iterations;
+        return sum > 0 ? elapsed : 0.0;
+    }
+
+    double UniqueFutures()
+    {
+        long long sum = 0;
+        auto const start = Clock::now();
+        for (int i = 0; i < Iterations; ++i)
+        {
+            azul::async::UniquePromise<int> promise;
+            auto future = promise.GetFuture();
+            for (int j = 0; j < ChainLength; ++j)
+            {
+                future = future.Then([](azul::async::UniqueFuture<int> value) { return value.Get() + 1; });
+            }
+
+            promise.SetValue(i);
+            sum += future.Get();
+        }
+        auto const elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / Iterations;
+        return sum > 0 ? elapsed : 0.0;
+    }
+}
+
+int main()
+{
+    std::printf("promise + %d continuations, shared futures: %.1f ns\n", ChainLength, SharedFutures());
+    std::printf("promise + %d continuations, unique futures: %.1f ns\n", ChainLength, UniqueFutures());
+    return 0;
+}
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <azul/async/Executor.hpp>
+#include <azul/async/Future.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/detail/IntrusiveMpscQueue.hpp>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            template <typename TState>
+            struct ActorMessage : IntrusiveMpscNode
+            {
+                virtual ~ActorMessage() = default;
+                virtual void Run(TState& state) noexcept = 0;
+                // called instead of Run if the actor could not be scheduled
+                virtual void Fail(std::exception_ptr const& exception) noexcept = 0;
+            };
+
+            template <typename TState, typename F>
+            struct TellMessage final : ActorMessage<TState>
+            {
+                explicit TellMessage(F&& message)
+                    : function(std::move(message))
+                {
+
+                }
+
+                // nobody waits for a told message, its exceptions are dropped
+                void Run(TState& state) noexcept override
+                {
+                    try
+                    {
+                        function(state);
+                    }
+                    catch (...)
+                    {
+                    }
+                }
+
+                void Fail(std::exception_ptr const&) noexcept override
+                {
+                }
+
+                F function;
+            };
+
+            template <typename TState, typename F, typename TResult>
+            struct AskMessage final : ActorMessage<TState>
+            {
+                explicit AskMessage(F&& message)
+                    : function(std::move(message))
+                {
+
+                }
+
+                void Run(TState& state) noexcept override
+                {
+                    try
+                    {
+                        if constexpr (std::is_void_v<TResult>)
+                        {
+                            function(state);
+                            promise.SetValue();
+                        }
+                        else
+                        {
+                            promise.SetValue(static_cast<TResult>(function(state)));
+                        }
+                    }
+                    catch (...)
+                    {
+                        promise.SetException(std::current_exception());
+                    }
+                }
+
+                void Fail(std::exception_ptr const& exception) noexcept override
+                {
+                    promise.SetException(exception);
+                }
+
+                F function;
+                Promise<TResult> promise;
+            };
+
+            // state and mailbox of one actor, an idle actor only consists of this (small) object
+            template <typename TState, typename TExecutor>
+            class ActorCell final : public std::enable_shared_from_this<ActorCell<TState, TExecutor>>
+            {
+            public:
+                template <typename... TArgs>
+                explicit ActorCell(TExecutor& executor, std::uint32_t const maxBatchSize, TArgs&&... args)
+                    : _executor(executor)
+                    , _maxBatchSize(std::max<std::uint32_t>(maxBatchSize, 1u))
+                    , _state(std::forward<TArgs>(args)...)
+                {
+
+                }
+
+                void Enqueue(ActorMessage<TState>* message)
+                {
+                    _mailbox.Push(message);
+
+                    // only the producer which observes the transition from idle to busy schedules the actor
+                    if (_pending.fetch_add(1, std::memory_order_acq_rel) == 0)
+                    {
+                        TrySchedule();
+                    }
+                }
+
+            private:
+                TExecutor& _executor;
+                std::uint32_t const _maxBatchSize;
+                std::atomic<std::uint32_t> _pending{ 0 };
+                IntrusiveMpscQueue<ActorMessage<TState>> _mailbox;
+                TState _state;
+
+                // an executor refusing the actor (by throwing, or through the future of the drain task if it is a
+                // bounded thread pool) would leave it busy forever, the announced messages are failed instead
+                // and the actor becomes idle again
+                void TrySchedule() noexcept
+                {
+                    try
+                    {
+                        Schedule();
+                    }
+                    catch (...)
+                    {
+                        Reject(std::current_exception());
+                    }
+                }
+
+                void Reject(std::exception_ptr const& exception) noexcept
+                {
+                    for (;;)
+                    {
+                        auto message = std::unique_ptr<ActorMessage<TState>>(_mailbox.TryPop());
+                        if (!message)
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+
+                        message->Fail(exception);
+                        message.reset();
+
+                        if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                void Schedule()
+                {
+                    auto drain = [self = this->shared_from_this()]() {
+                        self->Drain();
+                    };
+
+                    if constexpr (std::is_base_of_v<Executor, TExecutor>)
+                    {
+                        _executor.Post(std::move(drain));
+                    }
+                    else
+                    {
+                        detail::OnFailure(_executor.Execute(std::move(drain)), [weakSelf = this->weak_from_this()](std::exception_ptr const& exception) {
+                            if (auto const self = weakSelf.lock())
+                            {
+                                self->Reject(exception);
+                            }
+                        });
+                    }
+                }
+
+                // processes the messages one at a time, at most a batch before giving other actors a chance to run
+                void Drain()
+                {
+                    std::uint32_t processed = 0;
+
+                    for (;;)
+                    {
+                        auto message = std::unique_ptr<ActorMessage<TState>>(_mailbox.TryPop());
+                        if (!message)
+                        {
+                            // a producer already announced its message but did not link it into the mailbox yet
+                            std::this_thread::yield();
+                            continue;
+                        }
+
+                        message->Run(_state);
+                        message.reset();
+                        ++processed;
+
+                        if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        {
+                            break;
+                        }
+
+                        if (processed >= _maxBatchSize)
+                        {
+                            TrySchedule();
+                            break;
+                        }
+                    }
+                }
+            };
+        }
+
+        // owns a state which is only accessed by the messages sent to the actor, one message at a time
+        // and in the order they arrived, messages are callables taking the state (TState&)
+        // the actor runs on the executor (anything with Execute, or an Executor) only while it has messages,
+        // an idle actor does not occupy a thread and only costs its state plus a few pointers
+        template <typename TState, typename TExecutor = StaticThreadPool>
+        class Actor final
+        {
+        public:
+            template <typename... TArgs>
+            explicit Actor(std::shared_ptr<TExecutor> const& executor, std::uint32_t const maxBatchSize, TArgs&&... args)
+                : _executor(executor)
+                , _cell(std::make_shared<detail::ActorCell<TState, TExecutor>>(*executor, maxBatchSize, std::forward<TArgs>(args)...))
+            {
+
+            }
+
+            explicit Actor(std::shared_ptr<TExecutor> const& executor)
+                : Actor(executor, 64u)
+            {
+
+            }
+
+            Actor(Actor const&) = default;
+            Actor(Actor&&) = default;
+            Actor& operator=(Actor const&) = default;
+            Actor& operator=(Actor&&) = default;
+
+            // fire and forget, exceptions thrown by the message are dropped as is the message itself
+            // if the executor refuses to run the actor
+            template <typename F>
+            void Tell(F&& message)
+            {
+                using TMessage = detail::TellMessage<TState, std::decay_t<F>>;
+                _cell->Enqueue(new TMessage(std::decay_t<F>(std::forward<F>(message))));
+            }
+
+            // the future holds the result of the message (or its exception, or the exception of the executor
+            // refusing to run the actor)
+            template <typename F, typename TResult = std::decay_t<std::invoke_result_t<std::decay_t<F>&, TState&>>>
+            Future<TResult> Ask(F&& message)
+            {
+                using TMessage = detail::AskMessage<TState, std::decay_t<F>, TResult>;
+                auto request = std::make_unique<TMessage>(std::decay_t<F>(std::forward<F>(message)));
+                auto future = request->promise.GetFuture();
+
+                _cell->Enqueue(request.release());
+                return future;
+            }
+
+        private:
+            // owned by the handles only, the cell is kept alive by its pending drain tasks
+            std::shared_ptr<TExecutor> _executor;
+            std::shared_ptr<detail::ActorCell<TState, TExecutor>> _cell;
+        };
+    }
+}
@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        struct AsyncCacheOptions
+        {
+            // maximum number of entries (ready and in flight), zero means unbounded
+            std::size_t capacity = 0;
+            // number of independently locked shards
+            std::size_t shards = 16;
+            // time an entry stays valid after its computation has been started, zero means forever
+            std::chrono::steady_clock::duration timeToLive = std::chrono::steady_clock::duration::zero();
+        };
+
+        struct AsyncCacheStatistics
+        {
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+            std::uint64_t evictions = 0;
+        };
+
+        namespace detail
+        {
+            template <typename K, typename V, typename THash>
+            class AsyncCacheShard final
+            {
+            public:
+                using Clock = std::chrono::steady_clock;
+
+                struct Entry
+                {
+                    Future<V> future;
+                    Clock::time_point expiry;
+                    std::uint64_t id = 0;
+                    typename std::list<K>::iterator position;
+                    mutable std::atomic<bool> referenced{ false };
+                };
+
+                explicit AsyncCacheShard(std::size_t const capacity)
+                    : _capacity(capacity)
+                    , _hand(_clock.end())
+                {
+
+                }
+
+                // looks up a valid entry while holding the shard lock in shared mode only
+                std::optional<Future<V>> Find(K const& key, Clock::time_point const now) const
+                {
+                    std::shared_lock<std::shared_mutex> lock(_mutex);
+                    auto const entry = FindValid(key, now);
+                    if (!entry)
+                    {
+                        return std::nullopt;
+                    }
+                    return entry->future;
+                }
+
+                // returns the future of the valid entry for the key or inserts the given future as a new entry,
+                // the returned id is zero if an existing entry has been found
+                std::pair<Future<V>, std::uint64_t> FindOrInsert(K const& key, Future<V> const& future, Clock::time_point const expiry, Clock::time_point const now, std::size_t& evictions)
+                {
+                    std::unique_lock<std::shared_mutex> lock(_mutex);
+                    if (auto const entry = FindValid(key, now))
+                    {
+                        return { entry->future, 0 };
+                    }
+
+                    auto existing = _entries.find(key);
+                    if (existing != _entries.end())
+                    {
+                        Erase(existing);
+                    }
+                    else if (_capacity > 0 && _entries.size() >= _capacity)
+                    {
+                        evictions += EvictOne();
+                    }
+
+                    auto& entry = _entries[key];
+                    entry.future = future;
+                    entry.expiry = expiry;
+                    entry.id = ++_lastId;
+                    entry.position = _clock.insert(_hand, key);
+                    return { future, entry.id };
+                }
+
+                void Erase(K const& key, std::uint64_t const id)
+                {
+                    std::unique_lock<std::shared_mutex> lock(_mutex);
+                    auto const entry = _entries.find(key);
+                    if (entry != _entries.end() && entry->second.id == id)
+                    {
+                        Erase(entry);
+                    }
+                }
+
+                void Erase(K const& key)
+                {
+                    std::unique_lock<std::shared_mutex> lock(_mutex);
+                    auto const entry = _entries.find(key);
+                    if (entry != _entries.end())
+                    {
+                        Erase(entry);
+                    }
+                }
+
+                void Clear()
+                {
+                    std::unique_lock<std::shared_mutex> lock(_mutex);
+                    _entries.clear();
+                    _clock.clear();
+                    _hand = _clock.end();
+                }
+
+                std::size_t Size() const
+                {
+                    std::shared_lock<std::shared_mutex> lock(_mutex);
+                    return _entries.size();
+                }
+
+            private:
+                using EntryMap = std::unordered_map<K, Entry, THash>;
+
+                std::size_t const _capacity;
+
+                mutable std::shared_mutex _mutex;
+                EntryMap _entries;
+                std::list<K> _clock;
+                typename std::list<K>::iterator _hand;
+                std::uint64_t _lastId = 0;
+
+                Entry const* FindValid(K const& key, Clock::time_point const now) const
+                {
+                    auto const entry = _entries.find(key);
+                    if (entry == _entries.end() || entry->second.expiry <= now)
+                    {
+                        return nullptr;
+                    }
+
+                    // readers only set the reference bit, which is why the shared lock is sufficient
+                    entry->second.referenced.store(true, std::memory_order_relaxed);
+                    return &entry->second;
+                }
+
+                void Erase(typename EntryMap::iterator const entry)
+                {
+                    if (_hand == entry->second.position)
+                    {
+                        ++_hand;
+                    }
+                    _clock.erase(entry->second.position);
+                    _entries.erase(entry);
+                }
+
+                // CLOCK (second chance) eviction: the hand skips and clears referenced entries,
+                // entries still being computed are never evicted
+                std::size_t EvictOne()
+                {
+                    for (std::size_t i = 0; i < 2 * _clock.size(); ++i)
+                    {
+                        if (_hand == _clock.end())
+                        {
+                            _hand = _clock.begin();
+                        }
+
+                        auto const entry = _entries.find(*_hand);
+                        if (!entry->second.future.IsReady() || entry->second.referenced.exchange(false, std::memory_order_relaxed))
+                        {
+                            ++_hand;
+                            continue;
+                        }
+
+                        Erase(entry);
+                        return 1;
+                    }
+
+                    // everything is in flight, the shard temporarily exceeds its capacity
+                    return 0;
+                }
+            };
+        }
+
+        // asynchronous cache with single-flight loading: concurrent lookups of a missing key share
+        // one computation executed on the thread pool, failed computations (including loaders rejected or
+        // dropped by a bounded pool) are not cached
+        template <typename K, typename V, typename THash = std::hash<K>>
+        class AsyncCache final
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            explicit AsyncCache(std::shared_ptr<StaticThreadPool> const& executor, AsyncCacheOptions const& options = { })
+                : _executor(executor)
+                , _timeToLive(options.timeToLive)
+            {
+                auto const shards = std::max<std::size_t>(options.shards, 1u);
+                auto const capacityPerShard = options.capacity == 0 ? 0 : (options.capacity + shards - 1) / shards;
+
+                _shards.reserve(shards);
+                for (std::size_t i = 0; i < shards; ++i)
+                {
+                    _shards.emplace_back(std::make_shared<Shard>(capacityPerShard));
+                }
+            }
+
+            AsyncCache(AsyncCache const&) = delete;
+            AsyncCache(AsyncCache&&) = delete;
+            AsyncCache& operator=(AsyncCache const&) = delete;
+            AsyncCache& operator=(AsyncCache&&) = delete;
+
+            // returns the cached (or in flight) future for the key, on a miss the loader is executed on the pool
+            template <typename F>
+            Future<V> GetOrCompute(K const& key, F&& loader)
+            {
+                static_assert(std::is_convertible_v<std::invoke_result_t<F>, V>, "The loader has to return the value type of the cache.");
+
+                auto const shard = ShardOf(key);
+                auto const now = Clock::now();
+
+                if (auto future = shard->Find(key, now))
+                {
+                    _hits.fetch_add(1, std::memory_order_relaxed);
+                    return *future;
+                }
+
+                auto promise = std::make_shared<Promise<V>>();
+                std::size_t evictions = 0;
+                auto const inserted = shard->FindOrInsert(key, promise->GetFuture(), Expiry(now), now, evictions);
+                auto const id = inserted.second;
+                _evictions.fetch_add(evictions, std::memory_order_relaxed);
+
+                if (id == 0)
+                {
+                    // another lookup started the computation in the meantime
+                    _hits.fetch_add(1, std::memory_order_relaxed);
+                    return inserted.first;
+                }
+
+                _misses.fetch_add(1, std::memory_order_relaxed);
+
+                // the loader is submitted after the shard lock has been released, the pool might run it inline
+                // and the shard is kept alive in case the cache is destroyed before the computation completes
+                auto loaded = _executor->Execute([loader = std::forward<F>(loader)]() mutable {
+                    return V(loader());
+                });
+
+                // covers loaders which throw as well as loaders rejected or dropped by a bounded pool (a broken promise),
+                // the entry is removed before publishing the error so that later lookups retry
+                detail::OnFailure(loaded, [shard, key, id, promise](std::exception_ptr const& exception) {
+                    shard->Erase(key, id);
+                    promise->SetException(exception);
+                });
+                loaded.Then([promise](Future<V> result) {
+                    std::optional<V> value;
+                    try
+                    {
+                        value.emplace(result.Get());
+                    }
+                    catch (...)
+                    {
+                        return;
+                    }
+                    promise->SetValue(*value);
+                });
+
+                return inserted.first;
+            }
+
+            // returns the value if it is cached and its computation is completed
+            std::optional<V> TryGet(K const& key)
+            {
+                auto const future = ShardOf(key)->Find(key, Clock::now());
+                if (!future || !future->IsReady())
+                {
+                    return std::nullopt;
+                }
+
+                _hits.fetch_add(1, std::memory_order_relaxed);
+                return future->Get();
+            }
+
+            void Invalidate(K const& key)
+            {
+                ShardOf(key)->Erase(key);
+            }
+
+            void Clear()
+            {
+                for (auto& shard : _shards)
+                {
+                    shard->Clear();
+                }
+            }
+
+            std::size_t Size() const
+            {
+                std::size_t size = 0;
+                for (auto const& shard : _shards)
+                {
+                    size += shard->Size();
+                }
+                return size;
+            }
+
+            AsyncCacheStatistics Statistics() const
+            {
+                AsyncCacheStatistics statistics;
+                statistics.hits = _hits.load(std::memory_order_relaxed);
+                statistics.misses = _misses.load(std::memory_order_relaxed);
+                statistics.evictions = _evictions.load(std::memory_order_relaxed);
+                return statistics;
+            }
+
+        private:
+            using Shard = detail::AsyncCacheShard<K, V, THash>;
+
+            std::shared_ptr<StaticThreadPool> _executor;
+            Clock::duration const _timeToLive;
+            std::vector<std::shared_ptr<Shard>> _shards;
+
+            std::atomic<std::uint64_t> _hits{ 0 };
+            std::atomic<std::uint64_t> _misses{ 0 };
+            std::atomic<std::uint64_t> _evictions{ 0 };
+
+            std::shared_ptr<Shard> const& ShardOf(K const& key) const
+            {
+                return _shards[THash{}(key) % _shards.size()];
+            }
+
+            Clock::time_point Expiry(Clock::time_point const now) const
+            {
+                return _timeToLive == Clock::duration::zero() ? Clock::time_point::max() : now + _timeToLive;
+            }
+        };
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <azul/async/detail/MpscQueue.hpp>
+#include <thread>
+
+namespace azul
+{
+    namespace async
+    {
+        // counting semaphore whose Acquire returns a future instead of blocking the calling thread,
+        // waiters are queued without locks and resumed as continuations by the releasing thread
+        class AsyncSemaphore final
+        {
+        public:
+            explicit AsyncSemaphore(std::int64_t const permits)
+                : _count(permits)
+            {
+
+            }
+
+            AsyncSemaphore(AsyncSemaphore const&) = delete;
+            AsyncSemaphore(AsyncSemaphore&&) = delete;
+            AsyncSemaphore& operator=(AsyncSemaphore const&) = delete;
+            AsyncSemaphore& operator=(AsyncSemaphore&&) = delete;
+
+            // the returned future is ready as soon as a permit has been granted, a pending acquire whose futures were all
+            // dropped without attaching a continuation gives up waiting and the permit is passed on
+            Future<void> Acquire()
+            {
+                if (_count.fetch_sub(1, std::memory_order_acq_rel) > 0)
+                {
+                    return MakeReadyFuture();
+                }
+
+                Promise<void> promise;
+                auto future = promise.GetFuture();
+                _waiters.Push(std::move(promise));
+                return future;
+            }
+
+            bool TryAcquire()
+            {
+                auto count = _count.load(std::memory_order_relaxed);
+                while (count > 0)
+                {
+                    if (_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void Release(std::int64_t const permits = 1)
+            {
+                auto const previous = _count.fetch_add(permits, std::memory_order_acq_rel);
+                if (previous >= 0)
+                {
+                    return;
+                }
+
+                // a negative count is the number of waiters which announced themselves
+                auto const wakeups = static_cast<std::size_t>(std::min(permits, -previous));
+                if (_wakeups.fetch_add(wakeups, std::memory_order_acq_rel) == 0)
+                {
+                    ResumeWaiters();
+                }
+            }
+
+            std::int64_t Available() const noexcept
+            {
+                return std::max<std::int64_t>(_count.load(std::memory_order_acquire), 0);
+            }
+
+        private:
+            // permits minus the number of waiters
+            std::atomic<std::int64_t> _count;
+            std::atomic<std::size_t> _wakeups{ 0 };
+            detail::MpscQueue<Promise<void>> _waiters;
+
+            // only the releasing thread which observed no pending wakeups consumes the queue,
+            // concurrent releases (including those from resumed continuations) just add to its work
+            void ResumeWaiters()
+            {
+                for (;;)
+                {
+                    auto waiter = _waiters.TryPop();
+                    if (!waiter)
+                    {
+                        // the waiter already took its share of the count but did not link its promise yet
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    if (waiter->Abandoned())
+                    {
+                        // nobody can observe the permit, it is released again right away: it goes to the next waiter
+                        // (the wakeup is not used up) or, if there is none, back to the count
+                        waiter.reset();
+                        if (_count.fetch_add(1, std::memory_order_acq_rel) < 0)
+                        {
+                            continue;
+                        }
+                    }
+                    else
+                    {
+                        waiter->SetValue();
+                        waiter.reset();
+                    }
+
+                    if (_wakeups.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        break;
+                    }
+                }
+            }
+        };
+
+        // mutual exclusion for tasks: Lock returns a future which is ready once the mutex is owned,
+        // the owner does not have to be the thread which locked it
+        class AsyncMutex final
+        {
+        public:
+            AsyncMutex()
+                : _semaphore(1)
+            {
+
+            }
+
+            Future<void> Lock()
+            {
+                return _semaphore.Acquire();
+            }
+
+            bool TryLock()
+            {
+                return _semaphore.TryAcquire();
+            }
+
+            void Unlock()
+            {
+                _semaphore.Release();
+            }
+
+        private:
+            AsyncSemaphore _semaphore;
+        };
+    }
+}
@@ -0,0 +1,715 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <azul/async/Channel.hpp>
+#include <azul/async/Executor.hpp>
+#include <azul/async/Future.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            template <typename T>
+            class AsyncStreamSource
+            {
+            public:
+                virtual ~AsyncStreamSource() = default;
+
+                // must not be called again before the future returned by the previous call completed,
+                // once the end has been reported every further call reports the end again
+                virtual Future<std::optional<T>> Next() = 0;
+            };
+
+            // the executor a stage runs on, an empty optional runs the stage inline
+            // only the stream handles own the executors, a source owning one might destroy a thread pool on one of
+            // its own threads (which cannot join itself) once the last task referencing the source is done
+            using StageExecutor = std::optional<std::weak_ptr<Executor>>;
+
+            inline StageExecutor MakeStageExecutor(std::shared_ptr<Executor> const& executor)
+            {
+                if (!executor)
+                {
+                    return std::nullopt;
+                }
+                return std::weak_ptr<Executor>(executor);
+            }
+
+            template <typename F>
+            Future<std::invoke_result_t<F&>> InvokeInline(F& callable)
+            {
+                using TResult = std::invoke_result_t<F&>;
+
+                try
+                {
+                    return MakeReadyFuture(TResult(callable()));
+                }
+                catch (...)
+                {
+                    return MakeExceptionalFuture<TResult>(std::current_exception());
+                }
+            }
+
+            // runs the callable on the executor, or inline if there is none
+            // if the executor is already gone (every handle of the stream was destroyed) the fallback is invoked
+            // inline with a BrokenPromise error instead, the future is broken if the executor drops the task
+            template <typename F, typename FFallback>
+            Future<std::invoke_result_t<F&>> InvokeOn(StageExecutor const& executor, F&& callable, FFallback const& fallback)
+            {
+                using TResult = std::invoke_result_t<F&>;
+
+                if (!executor)
+                {
+                    return InvokeInline(callable);
+                }
+
+                auto const target = executor->lock();
+                if (!target)
+                {
+                    auto fail = [&fallback]() -> TResult {
+                        return fallback(std::make_exception_ptr(FutureError(FutureErrorCode::BrokenPromise)));
+                    };
+                    return InvokeInline(fail);
+                }
+
+                auto promise = std::make_shared<Promise<TResult>>();
+                auto future = promise->GetFuture();
+                target->Post([promise, callable = std::forward<F>(callable)]() {
+                    try
+                    {
+                        promise->SetValue(TResult(callable()));
+                    }
+                    catch (...)
+                    {
+                        promise->SetException(std::current_exception());
+                    }
+                });
+                return future;
+            }
+
+            // pulls values from the source until the step reports that it is done,
+            // values which are already available are handled in a loop and not recursively
+            template <typename T, typename FStep>
+            void PullUntil(std::shared_ptr<AsyncStreamSource<T>> const& source, FStep const& step)
+            {
+                for (;;)
+                {
+                    auto done = source->Next().Then(step);
+                    if (!done.IsReady())
+                    {
+                        done.Then([source, step](Future<bool> completed) {
+                            if (!completed.Get())
+                            {
+                                PullUntil(source, step);
+                            }
+                        });
+                        return;
+                    }
+
+                    if (done.Get())
+                    {
+                        return;
+                    }
+                }
+            }
+
+            // an error or a value (an empty value marks the end)
+            template <typename T>
+            struct AsyncStreamItem
+            {
+                std::optional<T> value;
+                std::exception_ptr error;
+                std::size_t source = 0;
+
+                static AsyncStreamItem From(Future<std::optional<T>> const& completed, std::size_t const source = 0)
+                {
+                    AsyncStreamItem item;
+                    item.source = source;
+                    try
+                    {
+                        item.value = completed.Get();
+                    }
+                    catch (...)
+                    {
+                        item.error = std::current_exception();
+                    }
+                    return item;
+                }
+
+                Future<std::optional<T>> ToFuture()
+                {
+                    if (error)
+                    {
+                        return MakeExceptionalFuture<std::optional<T>>(error);
+                    }
+                    return MakeReadyFuture(std::move(value));
+                }
+
+                void Complete(Promise<std::optional<T>>& promise)
+                {
+                    if (error)
+                    {
+                        promise.SetException(error);
+                        return;
+                    }
+                    promise.SetValue(value);
+                }
+            };
+
+            template <typename T, typename F>
+            class GeneratorSource final : public AsyncStreamSource<T>
+            {
+            public:
+                explicit GeneratorSource(F&& generator)
+                    : _generator(std::move(generator))
+                {
+
+                }
+
+                Future<std::optional<T>> Next() override
+                {
+                    if (*_ended)
+                    {
+                        return MakeReadyFuture(std::optional<T>());
+                    }
+
+                    try
+                    {
+                        if constexpr (std::is_same_v<std::invoke_result_t<F&>, Future<std::optional<T>>>)
+                        {
+                            return _generator().Then([ended = _ended](Future<std::optional<T>> next) {
+                                auto value = next.Get();
+                                *ended = !value;
+                                return value;
+                            });
+                        }
+                        else
+                        {
+                            std::optional<T> value(_generator());
+                            *_ended = !value;
+                            return MakeReadyFuture(std::move(value));
+                        }
+                    }
+                    catch (...)
+                    {
+                        return MakeExceptionalFuture<std::optional<T>>(std::current_exception());
+                    }
+                }
+
+            private:
+                F _generator;
+                // shared with the continuation of a pending value
+                std::shared_ptr<bool> _ended = std::make_shared<bool>(false);
+            };
+
+            template <typename T, typename TResult, typename F>
+            class MapSource final : public AsyncStreamSource<TResult>
+            {
+            public:
+                explicit MapSource(std::shared_ptr<AsyncStreamSource<T>> const& upstream, F&& callable, StageExecutor const& executor)
+                    : _upstream(upstream)
+                    , _callable(std::make_shared<F>(std::move(callable)))
+                    , _executor(executor)
+                {
+
+                }
+
+                Future<std::optional<TResult>> Next() override
+                {
+                    return _upstream->Next().Then([callable = _callable, executor = _executor](Future<std::optional<T>> next) {
+                        return InvokeOn(executor, [callable, next]() {
+                            auto value = next.Get();
+                            if (!value)
+                            {
+                                return std::optional<TResult>();
+                            }
+                            return std::optional<TResult>((*callable)(std::move(*value)));
+                        }, [](std::exception_ptr const& error) -> std::optional<TResult> {
+                            std::rethrow_exception(error);
+                        });
+                    });
+                }
+
+            private:
+                std::shared_ptr<AsyncStreamSource<T>> _upstream;
+                std::shared_ptr<F> _callable;
+                StageExecutor const _executor;
+            };
+
+            template <typename T, typename F>
+            class FilterSource final : public AsyncStreamSource<T>
+            {
+            public:
+                explicit FilterSource(std::shared_ptr<AsyncStreamSource<T>> const& upstream, F&& predicate, StageExecutor const& executor)
+                    : _upstream(upstream)
+                    , _predicate(std::make_shared<F>(std::move(predicate)))
+                    , _executor(executor)
+                {
+
+                }
+
+                Future<std::optional<T>> Next() override
+                {
+                    auto promise = std::make_shared<Promise<std::optional<T>>>();
+                    auto future = promise->GetFuture();
+
+                    PullUntil(_upstream, [predicate = _predicate, executor = _executor, promise](Future<std::optional<T>> next) {
+                        return InvokeOn(executor, [predicate, promise, next]() {
+                            try
+                            {
+                                auto value = next.Get();
+                                if (value.has_value() && !(*predicate)(std::as_const(*value)))
+                                {
+                                    return false;
+                                }
+                                promise->SetValue(value);
+                            }
+                            catch (...)
+                            {
+                                promise->SetException(std::current_exception());
+                            }
+                            return true;
+                        }, [promise](std::exception_ptr const& error) {
+                            promise->SetException(error);
+                            return true;
+                        });
+                    });
+                    return future;
+                }
+
+            private:
+                std::shared_ptr<AsyncStreamSource<T>> _upstream;
+                std::shared_ptr<F> _predicate;
+                StageExecutor const _executor;
+            };
+
+            template <typename T>
+            class BatchSource final : public AsyncStreamSource<std::vector<T>>
+            {
+            public:
+                explicit BatchSource(std::shared_ptr<AsyncStreamSource<T>> const& upstream, std::size_t const size)
+                    : _upstream(upstream)
+                    , _size(std::max<std::size_t>(size, 1u))
+                {
+
+                }
+
+                Future<std::optional<std::vector<T>>> Next() override
+                {
+                    auto promise = std::make_shared<Promise<std::optional<std::vector<T>>>>();
+                    auto future = promise->GetFuture();
+                    auto batch = std::make_shared<std::vector<T>>();
+                    batch->reserve(_size);
+
+                    PullUntil(_upstream, [size = _size, promise, batch](Future<std::optional<T>> next) {
+                        try
+                        {
+                            auto value = next.Get();
+                            if (value)
+                            {
+                                batch->emplace_back(std::move(*value));
+                                if (batch->size() < size)
+                                {
+                                    return MakeReadyFuture(false);
+                                }
+                            }
+
+                            // the last batch may be smaller, an empty one is not emitted
+                            promise->SetValue(batch->empty() ? std::optional<std::vector<T>>() : std::optional<std::vector<T>>(std::move(*batch)));
+                        }
+                        catch (...)
+                        {
+                            promise->SetException(std::current_exception());
+                        }
+                        return MakeReadyFuture(true);
+                    });
+                    return future;
+                }
+
+            private:
+                std::shared_ptr<AsyncStreamSource<T>> _upstream;
+                std::size_t const _size;
+            };
+
+            // prefetches up to capacity values, the upstream is pulled one value at a time
+            template <typename T>
+            class BufferSource final : public AsyncStreamSource<T>, public std::enable_shared_from_this<BufferSource<T>>
+            {
+            public:
+                explicit BufferSource(std::shared_ptr<AsyncStreamSource<T>> const& upstream, std::size_t const capacity)
+                    : _upstream(upstream)
+                    , _capacity(std::max<std::size_t>(capacity, 1u))
+                {
+
+                }
+
+                Future<std::optional<T>> Next() override
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (!_items.empty())
+                    {
+                        auto item = std::move(_items.front());
+                        _items.pop_front();
+                        lock.unlock();
+
+                        Fill();
+                        return item.ToFuture();
+                    }
+
+                    if (_finished)
+                    {
+                        return MakeReadyFuture(std::optional<T>());
+                    }
+
+                    _consumer.emplace();
+                    auto future = _consumer->GetFuture();
+                    lock.unlock();
+
+                    Fill();
+                    return future;
+                }
+
+            private:
+                std::shared_ptr<AsyncStreamSource<T>> _upstream;
+                std::size_t const _capacity;
+
+                std::mutex _mutex;
+                std::deque<AsyncStreamItem<T>> _items;
+                std::optional<Promise<std::optional<T>>> _consumer;
+                bool _pulling = false;
+                bool _finished = false;
+
+                void Fill()
+                {
+                    for (;;)
+                    {
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            if (_pulling || _finished || _items.size() >= _capacity)
+                            {
+                                return;
+                            }
+                            _pulling = true;
+                        }
+
+                        auto next = _upstream->Next();
+                        if (!next.IsReady())
+                        {
+                            next.Then([self = this->shared_from_this()](Future<std::optional<T>> completed) {
+                                self->Complete(completed);
+                                self->Fill();
+                            });
+                            return;
+                        }
+
+                        Complete(next);
+                    }
+                }
+
+                void Complete(Future<std::optional<T>> const& completed)
+                {
+                    auto item = AsyncStreamItem<T>::From(completed);
+                    std::optional<Promise<std::optional<T>>> consumer;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _pulling = false;
+                        // the upstream is not pulled again after its end or an error
+                        _finished = !item.value;
+
+                        if (_consumer)
+                        {
+                            consumer = std::move(_consumer);
+                            _consumer.reset();
+                        }
+                        else if (item.value.has_value() || item.error != nullptr)
+                        {
+                            _items.emplace_back(std::move(item));
+                        }
+                    }
+
+                    if (consumer)
+                    {
+                        item.Complete(*consumer);
+                    }
+                }
+            };
+
+            // pulls every idle source as soon as a value is requested and nothing is buffered,
+            // at most one value per source is held back until it is consumed
+            template <typename T>
+            class MergeSource final : public AsyncStreamSource<T>, public std::enable_shared_from_this<MergeSource<T>>
+            {
+            public:
+                explicit MergeSource(std::vector<std::shared_ptr<AsyncStreamSource<T>>>&& sources)
+                    : _sources(std::move(sources))
+                    , _busy(_sources.size(), false)
+                    , _ended(_sources.size(), false)
+                    , _active(_sources.size())
+                {
+
+                }
+
+                Future<std::optional<T>> Next() override
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (!_items.empty())
+                    {
+                        auto item = std::move(_items.front());
+                        _items.pop_front();
+                        _busy[item.source] = false;
+                        return item.ToFuture();
+                    }
+
+                    if (_active == 0)
+                    {
+                        return MakeReadyFuture(std::optional<T>());
+                    }
+
+                    _consumer.emplace();
+                    auto future = _consumer->GetFuture();
+
+                    std::vector<std::size_t> idle;
+                    for (std::size_t i = 0; i < _sources.size(); ++i)
+                    {
+                        if (!_busy[i] && !_ended[i])
+                        {
+                            _busy[i] = true;
+                            idle.push_back(i);
+                        }
+                    }
+                    lock.unlock();
+
+                    auto self = this->shared_from_this();
+                    for (auto const i : idle)
+                    {
+                        _sources[i]->Next().Then([self, i](Future<std::optional<T>> completed) {
+                            self->Complete(i, completed);
+                        });
+                    }
+                    return future;
+                }
+
+            private:
+                std::vector<std::shared_ptr<AsyncStreamSource<T>>> _sources;
+
+                std::mutex _mutex;
+                std::vector<bool> _busy;
+                std::vector<bool> _ended;
+                std::size_t _active;
+                std::deque<AsyncStreamItem<T>> _items;
+                std::optional<Promise<std::optional<T>>> _consumer;
+
+                void Complete(std::size_t const source, Future<std::optional<T>> const& completed)
+                {
+                    auto item = AsyncStreamItem<T>::From(completed, source);
+                    std::optional<Promise<std::optional<T>>> consumer;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        if (!item.value)
+                        {
+                            // an error ends the failing source only, the other sources keep going
+                            _ended[source] = true;
+                            --_active;
+                        }
+
+                        // the end of a single source is not reported, only the end of all of them
+                        bool const deliver = item.value.has_value() || item.error != nullptr || _active == 0;
+                        if (_consumer.has_value() && deliver)
+                        {
+                            consumer = std::move(_consumer);
+                            _consumer.reset();
+                            _busy[source] = false;
+                        }
+                        else if (item.value.has_value() || item.error != nullptr)
+                        {
+                            _items.emplace_back(std::move(item));
+                        }
+                    }
+
+                    if (consumer)
+                    {
+                        item.Complete(*consumer);
+                    }
+                }
+            };
+        }
+
+        // a sequence of asynchronously produced values, the end is reported by an empty optional
+        // streams are pull based: nothing is produced before a value is requested by Next and a producer
+        // never runs ahead of the consumer by more than the stream (e.g. a Buffer) allows
+        // Next must not be called again before the future returned by the previous call completed,
+        // copies and the streams created by the combinators share (and consume) the same source
+        template <typename T>
+        class AsyncStream final
+        {
+        public:
+            explicit AsyncStream(std::shared_ptr<detail::AsyncStreamSource<T>> const& source, std::vector<std::shared_ptr<Executor>> executors = {})
+                : _source(source)
+                , _executors(std::move(executors))
+            {
+
+            }
+
+            AsyncStream(AsyncStream const&) = default;
+            AsyncStream(AsyncStream&&) = default;
+            AsyncStream& operator=(AsyncStream const&) = default;
+            AsyncStream& operator=(AsyncStream&&) = default;
+
+            // the generator is invoked once per requested value and returns either a std::optional<T>
+            // or a Future<std::optional<T>>, an empty optional ends the stream
+            template <typename F>
+            static AsyncStream FromGenerator(F&& generator)
+            {
+                using TGenerator = std::decay_t<F>;
+                return AsyncStream(std::make_shared<detail::GeneratorSource<T, TGenerator>>(TGenerator(std::forward<F>(generator))));
+            }
+
+            static AsyncStream FromValues(std::vector<T> values)
+            {
+                return FromGenerator([values = std::move(values), index = std::size_t{ 0 }]() mutable {
+                    if (index == values.size())
+                    {
+                        return std::optional<T>();
+                    }
+                    return std::optional<T>(std::move(values[index++]));
+                });
+            }
+
+            // receives from the channel until it is closed and drained,
+            // producers sending to the channel are held back by its capacity
+            static AsyncStream FromChannel(Channel<T> channel)
+            {
+                return FromGenerator([channel]() mutable {
+                    return channel.Receive().Then([](Future<T> received) {
+                        try
+                        {
+                            return std::optional<T>(received.Get());
+                        }
+                        catch (FutureError const& error)
+                        {
+                            if (error.ErrorCode() != FutureErrorCode::ChannelClosed)
+                            {
+                                throw;
+                            }
+                            return std::optional<T>();
+                        }
+                    });
+                });
+            }
+
+            // values are interleaved in the order they become available, the stream ends once all streams ended
+            // an error of one stream is forwarded to the consumer, the remaining streams keep going
+            static AsyncStream Merge(std::vector<AsyncStream> const& streams)
+            {
+                std::vector<std::shared_ptr<detail::AsyncStreamSource<T>>> sources;
+                std::vector<std::shared_ptr<Executor>> executors;
+                sources.reserve(streams.size());
+                for (auto const& stream : streams)
+                {
+                    sources.push_back(stream._source);
+                    executors.insert(executors.end(), stream._executors.begin(), stream._executors.end());
+                }
+                return AsyncStream(std::make_shared<detail::MergeSource<T>>(std::move(sources)), std::move(executors));
+            }
+
+            Future<std::optional<T>> Next()
+            {
+                return _source->Next();
+            }
+
+            // the callable runs on the executor (or on the thread producing the value if there is none)
+            template <typename F, typename TResult = std::decay_t<std::invoke_result_t<std::decay_t<F>&, T>>>
+            AsyncStream<TResult> Map(F&& callable, std::shared_ptr<Executor> const& executor = nullptr) const
+            {
+                static_assert(!std::is_void_v<TResult>, "The callable has to return a value.");
+
+                using TCallable = std::decay_t<F>;
+                return AsyncStream<TResult>(std::make_shared<detail::MapSource<T, TResult, TCallable>>(_source, TCallable(std::forward<F>(callable)), detail::MakeStageExecutor(executor)), With(executor));
+            }
+
+            // values for which the predicate returns false are skipped
+            template <typename F>
+            AsyncStream Filter(F&& predicate, std::shared_ptr<Executor> const& executor = nullptr) const
+            {
+                using TPredicate = std::decay_t<F>;
+                return AsyncStream(std::make_shared<detail::FilterSource<T, TPredicate>>(_source, TPredicate(std::forward<F>(predicate)), detail::MakeStageExecutor(executor)), With(executor));
+            }
+
+            // lets the producer run ahead by up to capacity values
+            AsyncStream Buffer(std::size_t const capacity) const
+            {
+                return AsyncStream(std::make_shared<detail::BufferSource<T>>(_source, capacity), _executors);
+            }
+
+            // groups up to size values, the last batch may be smaller
+            AsyncStream<std::vector<T>> Batch(std::size_t const size) const
+            {
+                return AsyncStream<std::vector<T>>(std::make_shared<detail::BatchSource<T>>(_source, size), _executors);
+            }
+
+            AsyncStream Merge(AsyncStream const& other) const
+            {
+                return Merge(std::vector<AsyncStream>{ *this, other });
+            }
+
+            // consumes the stream, the returned future completes after the last value or holds the first error
+            // the stream has to be kept alive until then, a destroyed executor ends it with a BrokenPromise error
+            template <typename F>
+            Future<void> ForEach(F&& callable, std::shared_ptr<Executor> const& executor = nullptr) const
+            {
+                auto promise = std::make_shared<Promise<void>>();
+                auto future = promise->GetFuture();
+
+                detail::PullUntil(_source, [callable = std::make_shared<std::decay_t<F>>(std::forward<F>(callable)), executor = detail::MakeStageExecutor(executor), promise](Future<std::optional<T>> next) {
+                    return detail::InvokeOn(executor, [callable, promise, next]() {
+                        try
+                        {
+                            auto value = next.Get();
+                            if (!value)
+                            {
+                                promise->SetValue();
+                                return true;
+                            }
+                            (*callable)(std::move(*value));
+                            return false;
+                        }
+                        catch (...)
+                        {
+                            promise->SetException(std::current_exception());
+                        }
+                        return true;
+                    }, [promise](std::exception_ptr const& error) {
+                        promise->SetException(error);
+                        return true;
+                    });
+                });
+                return future;
+            }
+
+        private:
+            std::shared_ptr<detail::AsyncStreamSource<T>> _source;
+            // every executor a stage of this stream runs on, the sources only hold weak references
+            std::vector<std::shared_ptr<Executor>> _executors;
+
+            std::vector<std::shared_ptr<Executor>> With(std::shared_ptr<Executor> const& executor) const
+            {
+                auto executors = _executors;
+                if (executor)
+                {
+                    executors.push_back(executor);
+                }
+                return executors;
+            }
+        };
+    }
+}
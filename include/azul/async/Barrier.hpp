@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace azul
+{
+    namespace async
+    {
+        // reusable barrier for a fixed number of participants, ArriveAndWait returns a future which
+        // becomes ready once all participants arrived in the current phase
+        class Barrier final
+        {
+        public:
+            explicit Barrier(std::size_t const participants)
+                : _participants(participants)
+                , _remaining(participants)
+            {
+                if (participants == 0)
+                {
+                    throw std::invalid_argument("A barrier requires at least one participant.");
+                }
+            }
+
+            Barrier(Barrier const&) = delete;
+            Barrier(Barrier&&) = delete;
+            Barrier& operator=(Barrier const&) = delete;
+            Barrier& operator=(Barrier&&) = delete;
+
+            Future<void> ArriveAndWait()
+            {
+                Promise<void> completedPhase;
+                Future<void> future;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    future = _phase.GetFuture();
+                    if (--_remaining > 0)
+                    {
+                        return future;
+                    }
+
+                    // the last participant starts the next phase before releasing the current one
+                    completedPhase = std::exchange(_phase, Promise<void>());
+                    _remaining = _participants;
+                    ++_generation;
+                }
+
+                completedPhase.SetValue();
+                return future;
+            }
+
+            std::size_t Generation() const
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _generation;
+            }
+
+        private:
+            std::size_t const _participants;
+
+            mutable std::mutex _mutex;
+            std::size_t _remaining;
+            std::size_t _generation = 0;
+            Promise<void> _phase;
+        };
+    }
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <azul/async/Histogram.hpp>
+#include <azul/async/PromiseGroup.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/TimerService.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        struct BatcherOptions
+        {
+            // a batch is dispatched as soon as it contains this many requests
+            std::size_t maxBatchSize = 64;
+            // or once its first request waited this long (rounded up to the resolution of the timer service)
+            std::chrono::microseconds maxDelay = std::chrono::microseconds(1000);
+        };
+
+        struct BatcherStatistics
+        {
+            // number of requests per dispatched batch
+            HistogramSnapshot batchSize;
+            // time in microseconds between submitting a request and the start of its batch
+            HistogramSnapshot queueDelay;
+        };
+
+        namespace detail
+        {
+            template <typename TRequest, typename TResponse>
+            class BatcherState final : public std::enable_shared_from_this<BatcherState<TRequest, TResponse>>
+            {
+            public:
+                using Clock = std::chrono::steady_clock;
+                using BatchFunction = std::function<std::vector<TResponse>(std::vector<TRequest> const&)>;
+
+                explicit BatcherState(StaticThreadPool& executor, TimerService& timers, BatchFunction&& function, BatcherOptions const& options)
+                    : _executor(executor)
+                    , _timers(timers)
+                    , _function(std::move(function))
+                    , _options(options)
+                {
+                    _options.maxBatchSize = std::max<std::size_t>(_options.maxBatchSize, 1u);
+                }
+
+                Future<TResponse> Submit(TRequest&& request)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _pending.requests.push_back({ std::move(request), Clock::now() });
+                    auto future = _pending.promises.Add();
+
+                    if (_pending.requests.size() >= _options.maxBatchSize)
+                    {
+                        auto batch = TakeBatch();
+                        lock.unlock();
+
+                        Dispatch(std::move(batch));
+                    }
+                    else if (_pending.requests.size() == 1)
+                    {
+                        // the first request of a batch arms the timer, a timer of an earlier batch is ignored
+                        // because the generation changes whenever a batch is taken
+                        _timers.ExecuteAfter(_options.maxDelay, [weakSelf = this->weak_from_this(), generation = _generation]() {
+                            if (auto self = weakSelf.lock())
+                            {
+                                self->Flush(generation);
+                            }
+                        });
+                    }
+
+                    return future;
+                }
+
+                void Flush()
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    Flush(lock);
+                }
+
+                BatcherStatistics Statistics() const
+                {
+                    BatcherStatistics statistics;
+                    statistics.batchSize = _batchSize.Snapshot();
+                    statistics.queueDelay = _queueDelay.Snapshot();
+                    return statistics;
+                }
+
+            private:
+                struct PendingRequest
+                {
+                    TRequest request;
+                    Clock::time_point submitted;
+                };
+
+                // the responses of a batch are published together, continuations run once all promises are completed
+                struct Batch
+                {
+                    std::vector<PendingRequest> requests;
+                    PromiseGroup<TResponse> promises;
+                };
+
+                StaticThreadPool& _executor;
+                TimerService& _timers;
+                BatchFunction const _function;
+                BatcherOptions _options;
+
+                std::mutex _mutex;
+                Batch _pending;
+                std::uint64_t _generation = 0;
+
+                Histogram _batchSize;
+                Histogram _queueDelay;
+
+                Batch TakeBatch()
+                {
+                    ++_generation;
+                    Batch batch;
+                    std::swap(batch, _pending);
+                    _pending.requests.reserve(_options.maxBatchSize);
+                    return batch;
+                }
+
+                void Flush(std::uint64_t const generation)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (generation == _generation)
+                    {
+                        Flush(lock);
+                    }
+                }
+
+                void Flush(std::unique_lock<std::mutex>& lock)
+                {
+                    if (_pending.requests.empty())
+                    {
+                        return;
+                    }
+
+                    auto batch = TakeBatch();
+                    lock.unlock();
+
+                    Dispatch(std::move(batch));
+                }
+
+                void Dispatch(Batch&& batch)
+                {
+                    auto sharedBatch = std::make_shared<Batch>(std::move(batch));
+                    _executor.Execute([self = this->shared_from_this(), sharedBatch]() {
+                        self->Run(*sharedBatch);
+                    });
+                }
+
+                void Run(Batch& batch)
+                {
+                    auto const now = Clock::now();
+                    _batchSize.Record(batch.requests.size());
+
+                    std::vector<TRequest> requests;
+                    requests.reserve(batch.requests.size());
+                    for (auto& pending : batch.requests)
+                    {
+                        _queueDelay.Record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - pending.submitted).count()));
+                        requests.push_back(std::move(pending.request));
+                    }
+
+                    try
+                    {
+                        auto responses = _function(requests);
+                        if (responses.size() != batch.requests.size())
+                        {
+                            throw std::logic_error("The batch function has to return exactly one response per request.");
+                        }
+
+                        batch.promises.SetValues(responses);
+                    }
+                    catch (...)
+                    {
+                        // every request of the batch not fulfilled yet reports the failure
+                        batch.promises.SetExceptions(std::current_exception());
+                    }
+                }
+            };
+        }
+
+        // coalesces individually submitted requests into batches, each request gets its own future
+        // a batch is handed to the batch function on the thread pool once it is full or its first request waited long enough,
+        // the batch function returns the responses in the order of the requests
+        template <typename TRequest, typename TResponse>
+        class Batcher final
+        {
+        public:
+            using BatchFunction = typename detail::BatcherState<TRequest, TResponse>::BatchFunction;
+
+            explicit Batcher(std::shared_ptr<StaticThreadPool> const& executor, std::shared_ptr<TimerService> const& timers, BatchFunction function, BatcherOptions const& options = { })
+                : _executor(executor)
+                , _timers(timers)
+                , _state(std::make_shared<detail::BatcherState<TRequest, TResponse>>(*executor, *timers, std::move(function), options))
+            {
+
+            }
+
+            // dispatches the requests still waiting for their batch to fill up
+            ~Batcher()
+            {
+                _state->Flush();
+            }
+
+            Batcher(Batcher const&) = delete;
+            Batcher(Batcher&&) = delete;
+            Batcher& operator=(Batcher const&) = delete;
+            Batcher& operator=(Batcher&&) = delete;
+
+            Future<TResponse> Submit(TRequest request)
+            {
+                return _state->Submit(std::move(request));
+            }
+
+            // dispatches the current batch without waiting for it to fill up
+            void Flush()
+            {
+                _state->Flush();
+            }
+
+            BatcherStatistics Statistics() const
+            {
+                return _state->Statistics();
+            }
+
+        private:
+            // owned by the handle, pending batches and flush timers merely reference the pool and the timer service
+            std::shared_ptr<StaticThreadPool> _executor;
+            std::shared_ptr<TimerService> _timers;
+            std::shared_ptr<detail::BatcherState<TRequest, TResponse>> _state;
+        };
+    }
+}
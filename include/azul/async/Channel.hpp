@@ -0,0 +1,353 @@
+#pragma once
+
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            template <typename T>
+            class ChannelState final
+            {
+            public:
+                explicit ChannelState(std::size_t const capacity, std::shared_ptr<StaticThreadPool> const& executor)
+                    : _executor(executor)
+                    , _buffer(capacity)
+                {
+
+                }
+
+                template <typename U>
+                bool TrySend(U&& value)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (_closed)
+                    {
+                        return false;
+                    }
+
+                    if (auto receiver = PopReceiver())
+                    {
+                        lock.unlock();
+
+                        Resume(std::move(*receiver), T(std::forward<U>(value)));
+                        return true;
+                    }
+
+                    if (_count == _buffer.size())
+                    {
+                        return false;
+                    }
+
+                    PushBack(std::forward<U>(value));
+                    return true;
+                }
+
+                Future<void> Send(T&& value)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (_closed)
+                    {
+                        return MakeExceptionalFuture<void>(FutureError(FutureErrorCode::ChannelClosed));
+                    }
+
+                    if (auto receiver = PopReceiver())
+                    {
+                        lock.unlock();
+
+                        Resume(std::move(*receiver), std::move(value));
+                        return MakeReadyFuture();
+                    }
+
+                    if (_count < _buffer.size())
+                    {
+                        PushBack(std::move(value));
+                        return MakeReadyFuture();
+                    }
+
+                    // the channel is full, the sender is parked together with its value
+                    Promise<void> promise;
+                    auto future = promise.GetFuture();
+                    _senders.push_back({ std::move(value), std::move(promise) });
+                    return future;
+                }
+
+                std::optional<T> TryReceive()
+                {
+                    std::optional<Promise<void>> sender;
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    auto value = PopFront(sender);
+                    lock.unlock();
+
+                    if (sender)
+                    {
+                        Resume(std::move(*sender));
+                    }
+                    return value;
+                }
+
+                Future<T> Receive()
+                {
+                    std::optional<Promise<void>> sender;
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (auto value = PopFront(sender))
+                    {
+                        lock.unlock();
+
+                        if (sender)
+                        {
+                            Resume(std::move(*sender));
+                        }
+                        return MakeReadyFuture(std::move(*value));
+                    }
+
+                    if (_closed)
+                    {
+                        return MakeExceptionalFuture<T>(FutureError(FutureErrorCode::ChannelClosed));
+                    }
+
+                    Promise<T> promise;
+                    auto future = promise.GetFuture();
+                    _receivers.push_back(std::move(promise));
+                    return future;
+                }
+
+                void Close()
+                {
+                    std::deque<Promise<T>> receivers;
+                    std::deque<ParkedSender> senders;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        if (_closed)
+                        {
+                            return;
+                        }
+
+                        _closed = true;
+                        receivers.swap(_receivers);
+                        senders.swap(_senders);
+                    }
+
+                    // buffered values stay receivable, everybody still waiting is released with an error
+                    auto const error = std::make_exception_ptr(FutureError(FutureErrorCode::ChannelClosed));
+                    for (auto& receiver : receivers)
+                    {
+                        receiver.SetException(error);
+                    }
+                    for (auto& sender : senders)
+                    {
+                        sender.promise.SetException(error);
+                    }
+                }
+
+                bool Closed() const
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    return _closed;
+                }
+
+                std::size_t Size() const
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    return _count;
+                }
+
+                std::size_t Capacity() const noexcept
+                {
+                    return _buffer.size();
+                }
+
+            private:
+                struct ParkedSender
+                {
+                    T value;
+                    Promise<void> promise;
+                };
+
+                std::shared_ptr<StaticThreadPool> _executor;
+
+                mutable std::mutex _mutex;
+                std::vector<std::optional<T>> _buffer;
+                std::size_t _head = 0;
+                std::size_t _count = 0;
+                bool _closed = false;
+
+                std::deque<Promise<T>> _receivers;
+                std::deque<ParkedSender> _senders;
+
+                // the oldest receiver still waiting for its value, receivers whose futures have all been dropped
+                // (e.g. a cancelled Receive) are skipped so that the value is not lost to them
+                std::optional<Promise<T>> PopReceiver()
+                {
+                    while (!_receivers.empty())
+                    {
+                        auto receiver = std::move(_receivers.front());
+                        _receivers.pop_front();
+                        if (!receiver.Abandoned())
+                        {
+                            return std::optional<Promise<T>>(std::move(receiver));
+                        }
+                    }
+                    return std::nullopt;
+                }
+
+                template <typename U>
+                void PushBack(U&& value)
+                {
+                    _buffer[(_head + _count) % _buffer.size()].emplace(std::forward<U>(value));
+                    ++_count;
+                }
+
+                // takes the oldest value and lets the oldest parked sender (if any) move up,
+                // the promise of that sender has to be completed after the lock has been released
+                std::optional<T> PopFront(std::optional<Promise<void>>& releasedSender)
+                {
+                    if (_count == 0)
+                    {
+                        // unbuffered channels hand values over from the parked senders directly
+                        if (_senders.empty())
+                        {
+                            return std::nullopt;
+                        }
+
+                        auto sender = std::move(_senders.front());
+                        _senders.pop_front();
+                        releasedSender.emplace(std::move(sender.promise));
+                        return std::optional<T>(std::move(sender.value));
+                    }
+
+                    auto& slot = _buffer[_head];
+                    std::optional<T> value(std::move(*slot));
+                    slot.reset();
+                    _head = (_head + 1) % _buffer.size();
+                    --_count;
+
+                    if (!_senders.empty())
+                    {
+                        auto sender = std::move(_senders.front());
+                        _senders.pop_front();
+                        PushBack(std::move(sender.value));
+                        releasedSender.emplace(std::move(sender.promise));
+                    }
+                    return value;
+                }
+
+                void Resume(Promise<T>&& receiver, T&& value)
+                {
+                    if (!_executor)
+                    {
+                        receiver.SetValue(value);
+                        return;
+                    }
+
+                    // continuations of the receiver run on the pool and not on the sending thread
+                    auto sharedReceiver = std::make_shared<Promise<T>>(std::move(receiver));
+                    auto sharedValue = std::make_shared<T>(std::move(value));
+                    _executor->Execute([sharedReceiver, sharedValue]() {
+                        sharedReceiver->SetValue(*sharedValue);
+                    });
+                }
+
+                void Resume(Promise<void>&& sender)
+                {
+                    if (!_executor)
+                    {
+                        sender.SetValue();
+                        return;
+                    }
+
+                    auto sharedSender = std::make_shared<Promise<void>>(std::move(sender));
+                    _executor->Execute([sharedSender]() {
+                        sharedSender->SetValue();
+                    });
+                }
+            };
+        }
+
+        // bounded multi-producer multi-consumer channel, copies refer to the same channel
+        // Send and Receive never block: they return futures which complete as soon as space or a value is available,
+        // waiters are resumed on the given pool (or on the thread completing them if no pool is given)
+        // a capacity of zero creates an unbuffered channel where every Send waits for a matching Receive
+        template <typename T>
+        class Channel final
+        {
+        public:
+            explicit Channel(std::size_t const capacity, std::shared_ptr<StaticThreadPool> const& executor = nullptr)
+                : _state(std::make_shared<detail::ChannelState<T>>(capacity, executor))
+            {
+
+            }
+
+            Channel(Channel const&) = default;
+            Channel(Channel&&) = default;
+            Channel& operator=(Channel const&) = default;
+            Channel& operator=(Channel&&) = default;
+
+            // returns a future which completes once the value has been accepted by the channel,
+            // it holds a FutureError(ChannelClosed) if the channel is closed before
+            Future<void> Send(T value)
+            {
+                return _state->Send(std::move(value));
+            }
+
+            // returns false without consuming the value if the channel is full or closed
+            bool TrySend(T const& value)
+            {
+                return _state->TrySend(value);
+            }
+
+            bool TrySend(T&& value)
+            {
+                return _state->TrySend(std::move(value));
+            }
+
+            // returns a future holding the next value, it holds a FutureError(ChannelClosed)
+            // if the channel is closed and drained, a receive whose futures were all dropped without attaching a continuation
+            // is cancelled and does not consume a value
+            Future<T> Receive()
+            {
+                return _state->Receive();
+            }
+
+            std::optional<T> TryReceive()
+            {
+                return _state->TryReceive();
+            }
+
+            void Close()
+            {
+                _state->Close();
+            }
+
+            bool Closed() const
+            {
+                return _state->Closed();
+            }
+
+            std::size_t Size() const
+            {
+                return _state->Size();
+            }
+
+            std::size_t Capacity() const noexcept
+            {
+                return _state->Capacity();
+            }
+
+        private:
+            std::shared_ptr<detail::ChannelState<T>> _state;
+        };
+    }
+}
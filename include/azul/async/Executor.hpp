@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace azul
+{
+    namespace async
+    {
+        // type erased scheduler, lets code accept any executor without being templated on it
+        // the concrete executors of the library are adapted through MakeExecutor
+        class Executor
+        {
+        public:
+            virtual ~Executor() = default;
+
+            // runs the task at some point, exceptions thrown by the task are the task's business
+            virtual void Post(std::function<void()> task) = 0;
+
+            // number of tasks the executor runs at the same time, used to partition work
+            virtual std::size_t Concurrency() const noexcept = 0;
+        };
+
+        // runs every task immediately on the posting thread
+        class InlineExecutor final : public Executor
+        {
+        public:
+            void Post(std::function<void()> task) override
+            {
+                task();
+            }
+
+            std::size_t Concurrency() const noexcept override
+            {
+                return 1u;
+            }
+        };
+
+        namespace detail
+        {
+            template <typename TExecutor, typename = void>
+            struct HasThreadCount : std::false_type
+            {
+            };
+
+            template <typename TExecutor>
+            struct HasThreadCount<TExecutor, std::void_t<decltype(std::declval<TExecutor const&>().ThreadCount())>> : std::true_type
+            {
+            };
+        }
+
+        // adapts any executor with an Execute(callable) member (StaticThreadPool, Strand, SpinningExecutor, FiberExecutor)
+        // executors without a ThreadCount member (like a strand) report a concurrency of one
+        template <typename TExecutor>
+        class ExecutorAdapter final : public Executor
+        {
+        public:
+            explicit ExecutorAdapter(std::shared_ptr<TExecutor> const& executor)
+                : _executor(executor)
+            {
+                if (!_executor)
+                {
+                    throw std::invalid_argument("The adapted executor must not be null.");
+                }
+            }
+
+            void Post(std::function<void()> task) override
+            {
+                _executor->Execute(std::move(task));
+            }
+
+            std::size_t Concurrency() const noexcept override
+            {
+                if constexpr (detail::HasThreadCount<TExecutor>::value)
+                {
+                    return std::max<std::size_t>(_executor->ThreadCount(), 1u);
+                }
+                else
+                {
+                    return 1u;
+                }
+            }
+
+            std::shared_ptr<TExecutor> const& Underlying() const noexcept
+            {
+                return _executor;
+            }
+
+        private:
+            std::shared_ptr<TExecutor> _executor;
+        };
+
+        template <typename TExecutor>
+        std::shared_ptr<Executor> MakeExecutor(std::shared_ptr<TExecutor> const& executor)
+        {
+            if constexpr (std::is_base_of_v<Executor, TExecutor>)
+            {
+                return executor;
+            }
+            else
+            {
+                return std::make_shared<ExecutorAdapter<TExecutor>>(executor);
+            }
+        }
+    }
+}
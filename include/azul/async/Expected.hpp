@@ -0,0 +1,273 @@
+#pragma once
+
+#include <azul/async/Future.hpp>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace azul
+{
+    namespace async
+    {
+        template <typename E>
+        class Unexpected final
+        {
+        public:
+            explicit Unexpected(E error)
+                : _error(std::move(error))
+            {
+
+            }
+
+            E const& Error() const& noexcept
+            {
+                return _error;
+            }
+
+            E&& Error() && noexcept
+            {
+                return std::move(_error);
+            }
+
+        private:
+            E _error;
+        };
+
+        template <typename E>
+        Unexpected<std::decay_t<E>> MakeUnexpected(E&& error)
+        {
+            return Unexpected<std::decay_t<E>>(std::forward<E>(error));
+        }
+
+        class BadExpectedAccess : public std::logic_error
+        {
+        public:
+            BadExpectedAccess()
+                : std::logic_error("Accessing the value of an Expected holding an error (or vice versa).")
+            {
+
+            }
+        };
+
+        // holds either a value or an error, expected failures travel through it without throwing
+        template <typename T, typename E>
+        class Expected final
+        {
+        public:
+            using ValueType = T;
+            using ErrorType = E;
+
+            Expected()
+                : _storage(std::in_place_index<0>)
+            {
+
+            }
+
+            Expected(T value)
+                : _storage(std::in_place_index<0>, std::move(value))
+            {
+
+            }
+
+            Expected(Unexpected<E> error)
+                : _storage(std::in_place_index<1>, std::move(error))
+            {
+
+            }
+
+            bool HasValue() const noexcept
+            {
+                return _storage.index() == 0;
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return HasValue();
+            }
+
+            T const& Value() const&
+            {
+                CheckValue();
+                return *std::get_if<0>(&_storage);
+            }
+
+            T& Value() &
+            {
+                CheckValue();
+                return *std::get_if<0>(&_storage);
+            }
+
+            T&& Value() &&
+            {
+                CheckValue();
+                return std::move(*std::get_if<0>(&_storage));
+            }
+
+            E const& Error() const
+            {
+                CheckError();
+                return std::get_if<1>(&_storage)->Error();
+            }
+
+        private:
+            std::variant<T, Unexpected<E>> _storage;
+
+            void CheckValue() const
+            {
+                if (!HasValue())
+                {
+                    throw BadExpectedAccess();
+                }
+            }
+
+            void CheckError() const
+            {
+                if (HasValue())
+                {
+                    throw BadExpectedAccess();
+                }
+            }
+        };
+
+        template <typename E>
+        class Expected<void, E> final
+        {
+        public:
+            using ValueType = void;
+            using ErrorType = E;
+
+            Expected()
+            {
+
+            }
+
+            Expected(Unexpected<E> error)
+                : _error(std::move(error))
+            {
+
+            }
+
+            bool HasValue() const noexcept
+            {
+                return !_error.has_value();
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return HasValue();
+            }
+
+            void Value() const
+            {
+                if (!HasValue())
+                {
+                    throw BadExpectedAccess();
+                }
+            }
+
+            E const& Error() const
+            {
+                if (HasValue())
+                {
+                    throw BadExpectedAccess();
+                }
+                return _error->Error();
+            }
+
+        private:
+            std::optional<Unexpected<E>> _error;
+        };
+
+        namespace detail
+        {
+            template <typename T>
+            struct IsExpected : std::false_type
+            {
+            };
+
+            template <typename T, typename E>
+            struct IsExpected<Expected<T, E>> : std::true_type
+            {
+            };
+
+            template <typename TResult, typename TExpected, typename F>
+            TResult HasValueOr(TExpected const& expected, F&& onValue)
+            {
+                if (!expected.HasValue())
+                {
+                    return TResult(Unexpected<typename TResult::ErrorType>(expected.Error()));
+                }
+                return onValue();
+            }
+
+            // invokes the callable with the value of the expected (if any) and wraps the result,
+            // callables already returning an Expected are not wrapped a second time
+            template <typename TExpected, typename F>
+            auto InvokeWithValue(TExpected&& expected, F& callable)
+            {
+                using T = typename std::decay_t<TExpected>::ValueType;
+                using E = typename std::decay_t<TExpected>::ErrorType;
+
+                if constexpr (std::is_void_v<T>)
+                {
+                    using TResult = std::invoke_result_t<F&>;
+                    if constexpr (IsExpected<TResult>::value)
+                    {
+                        return HasValueOr<TResult>(expected, [&]() { return callable(); });
+                    }
+                    else if constexpr (std::is_void_v<TResult>)
+                    {
+                        return HasValueOr<Expected<void, E>>(expected, [&]() { callable(); return Expected<void, E>(); });
+                    }
+                    else
+                    {
+                        return HasValueOr<Expected<TResult, E>>(expected, [&]() { return Expected<TResult, E>(callable()); });
+                    }
+                }
+                else
+                {
+                    using TResult = std::invoke_result_t<F&, T>;
+                    if constexpr (IsExpected<TResult>::value)
+                    {
+                        return HasValueOr<TResult>(expected, [&]() { return callable(std::forward<TExpected>(expected).Value()); });
+                    }
+                    else if constexpr (std::is_void_v<TResult>)
+                    {
+                        return HasValueOr<Expected<void, E>>(expected, [&]() { callable(std::forward<TExpected>(expected).Value()); return Expected<void, E>(); });
+                    }
+                    else
+                    {
+                        return HasValueOr<Expected<TResult, E>>(expected, [&]() { return Expected<TResult, E>(callable(std::forward<TExpected>(expected).Value())); });
+                    }
+                }
+            }
+        }
+
+        // continuation for futures of Expected values: the callable is only invoked with the value,
+        // errors are passed on without invoking it and without throwing
+        template <typename T, typename E, typename F>
+        auto ThenValue(Future<Expected<T, E>> future, F&& callable)
+        {
+            return future.Then([callable = std::forward<F>(callable)](Future<Expected<T, E>> f) mutable {
+                return detail::InvokeWithValue(f.Get(), callable);
+            });
+        }
+
+        // continuation for futures of Expected values which is only invoked with the error,
+        // the callable returns a replacement Expected<T, E> (e.g. a fallback value or another error)
+        template <typename T, typename E, typename F>
+        Future<Expected<T, E>> ThenError(Future<Expected<T, E>> future, F&& callable)
+        {
+            return future.Then([callable = std::forward<F>(callable)](Future<Expected<T, E>> f) mutable -> Expected<T, E> {
+                auto result = f.Get();
+                if (result.HasValue())
+                {
+                    return result;
+                }
+                return callable(result.Error());
+            });
+        }
+    }
+}
@@ -0,0 +1,365 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <azul/async/Task.hpp>
+#include <azul/async/detail/Trampoline.hpp>
+#include <azul/async/detail/WaitHook.hpp>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <thread>
+#include <ucontext.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        struct FiberExecutorOptions
+        {
+            // usable stack size of every fiber, a guard page is added below it
+            std::size_t stackSize = 256 * 1024;
+            // number of stacks of finished fibers each thread keeps for reuse
+            std::size_t pooledStacksPerThread = 64;
+        };
+
+        namespace detail
+        {
+            class FiberStack final
+            {
+            public:
+                explicit FiberStack(std::size_t const size)
+                {
+                    auto const pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                    _size = ((size + pageSize - 1) / pageSize + 1) * pageSize;
+
+                    _memory = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+                    if (_memory == MAP_FAILED)
+                    {
+                        throw std::bad_alloc();
+                    }
+
+                    // stacks grow downwards, an overflow hits the guard page instead of foreign memory
+                    ::mprotect(_memory, pageSize, PROT_NONE);
+                }
+
+                ~FiberStack()
+                {
+                    if (_memory)
+                    {
+                        ::munmap(_memory, _size);
+                    }
+                }
+
+                FiberStack(FiberStack const&) = delete;
+                FiberStack& operator=(FiberStack const&) = delete;
+
+                FiberStack(FiberStack&& other) noexcept
+                    : _memory(std::exchange(other._memory, nullptr))
+                    , _size(other._size)
+                {
+
+                }
+
+                FiberStack& operator=(FiberStack&& other) noexcept
+                {
+                    std::swap(_memory, other._memory);
+                    std::swap(_size, other._size);
+                    return *this;
+                }
+
+                void* Memory() const noexcept
+                {
+                    return _memory;
+                }
+
+                std::size_t Size() const noexcept
+                {
+                    return _size;
+                }
+
+            private:
+                void* _memory = nullptr;
+                std::size_t _size = 0;
+            };
+
+            struct Fiber final
+            {
+                explicit Fiber(std::shared_ptr<TaskBase>&& fiberTask)
+                    : task(std::move(fiberTask))
+                {
+
+                }
+
+                std::shared_ptr<TaskBase> task;
+                std::unique_ptr<FiberStack> stack;
+                ucontext_t context{ };
+                Trampoline::Context trampoline;
+                bool started = false;
+                bool finished = false;
+            };
+
+            // one thread of the fiber executor, fibers never migrate between threads
+            class FiberWorker final : public WaitHook, public std::enable_shared_from_this<FiberWorker>
+            {
+            public:
+                explicit FiberWorker(FiberExecutorOptions const& options)
+                    : _options(options)
+                {
+
+                }
+
+                void Start()
+                {
+                    _thread = std::thread([self = shared_from_this()]() {
+                        self->ThreadLoop();
+                    });
+                }
+
+                void Stop()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _shutdownInitiated = true;
+                        _condition.notify_all();
+                    }
+                    _thread.join();
+                }
+
+                void Schedule(std::shared_ptr<Fiber> fiber)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _ready.emplace_back(std::move(fiber));
+                    _condition.notify_one();
+                }
+
+                void Suspend(std::function<void(WakeFunction const&)> const& subscribe) override
+                {
+                    auto waker = std::make_shared<Waker>(shared_from_this(), _current);
+                    subscribe([waker]() { waker->Wake(); });
+                    waker.reset();
+
+                    // the fiber is already in the ready queue if the wake function has been invoked in the meantime,
+                    // it is nevertheless resumed only after it switched back because only this thread resumes it
+                    ::swapcontext(&_current->context, &_schedulerContext);
+                }
+
+            private:
+                // schedules the fiber again once invoked or destroyed (whichever happens first)
+                // a completed future keeps its continuations, and with them the waker, until it is destroyed:
+                // the worker is therefore only referenced weakly and the fiber is handed over on wake
+                class Waker final
+                {
+                public:
+                    explicit Waker(std::shared_ptr<FiberWorker> const& worker, std::shared_ptr<Fiber> const& fiber)
+                        : _worker(worker)
+                        , _fiber(fiber)
+                    {
+
+                    }
+
+                    ~Waker()
+                    {
+                        Wake();
+                    }
+
+                    void Wake()
+                    {
+                        if (!_woken.exchange(true, std::memory_order_acq_rel))
+                        {
+                            // a fiber of a worker which is already gone is never resumed
+                            if (auto const worker = _worker.lock())
+                            {
+                                worker->Schedule(std::move(_fiber));
+                            }
+                            _fiber.reset();
+                            _worker.reset();
+                        }
+                    }
+
+                private:
+                    std::weak_ptr<FiberWorker> _worker;
+                    std::shared_ptr<Fiber> _fiber;
+                    std::atomic<bool> _woken{ false };
+                };
+
+                FiberExecutorOptions const _options;
+
+                std::mutex _mutex;
+                std::condition_variable _condition;
+                std::deque<std::shared_ptr<Fiber>> _ready;
+                bool _shutdownInitiated = false;
+                std::thread _thread;
+
+                // only accessed by the thread of the worker
+                ucontext_t _schedulerContext{ };
+                std::shared_ptr<Fiber> _current;
+                std::vector<std::unique_ptr<FiberStack>> _stacks;
+
+                static FiberWorker*& CurrentWorker() noexcept
+                {
+                    static thread_local FiberWorker* current = nullptr;
+                    return current;
+                }
+
+                static void FiberEntry()
+                {
+                    auto& fiber = *CurrentWorker()->_current;
+                    fiber.task->operator()();
+                    fiber.finished = true;
+                    // returning switches to the scheduler context through uc_link
+                }
+
+                void ThreadLoop()
+                {
+                    CurrentWorker() = this;
+
+                    for (;;)
+                    {
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _condition.wait(lock, [this]() { return !_ready.empty() || _shutdownInitiated; });
+                            if (_ready.empty())
+                            {
+                                break;
+                            }
+
+                            _current = std::move(_ready.front());
+                            _ready.pop_front();
+                        }
+
+                        if (!_current->started)
+                        {
+                            Prepare(*_current);
+                        }
+
+                        Run(*_current);
+
+                        if (_current->finished)
+                        {
+                            Recycle(*_current);
+                        }
+                        _current.reset();
+                    }
+
+                    CurrentWorker() = nullptr;
+                }
+
+                void Prepare(Fiber& fiber)
+                {
+                    if (_stacks.empty())
+                    {
+                        fiber.stack = std::make_unique<FiberStack>(_options.stackSize);
+                    }
+                    else
+                    {
+                        fiber.stack = std::move(_stacks.back());
+                        _stacks.pop_back();
+                    }
+
+                    ::getcontext(&fiber.context);
+                    fiber.context.uc_stack.ss_sp = fiber.stack->Memory();
+                    fiber.context.uc_stack.ss_size = fiber.stack->Size();
+                    fiber.context.uc_link = &_schedulerContext;
+                    ::makecontext(&fiber.context, &FiberWorker::FiberEntry, 0);
+                    fiber.started = true;
+                }
+
+                void Run(Fiber& fiber)
+                {
+                    auto const previousHook = WaitHook::Current();
+                    WaitHook::Current() = this;
+                    Trampoline::SwapContext(fiber.trampoline);
+
+                    ::swapcontext(&_schedulerContext, &fiber.context);
+
+                    Trampoline::SwapContext(fiber.trampoline);
+                    WaitHook::Current() = previousHook;
+                }
+
+                void Recycle(Fiber& fiber)
+                {
+                    if (_stacks.size() < _options.pooledStacksPerThread)
+                    {
+                        _stacks.emplace_back(std::move(fiber.stack));
+                    }
+                    fiber.stack.reset();
+                    fiber.task.reset();
+                }
+            };
+        }
+
+        // runs every task on its own stackful fiber, a fixed set of threads multiplexes the fibers
+        // Get/Wait on a future inside a fiber suspend the fiber instead of blocking the thread, the thread meanwhile
+        // runs other fibers (WaitFor still blocks), so a few threads can serve a large number of waiting tasks
+        // fibers are pinned to the thread which started them, thread local storage therefore stays valid across waits
+        // fibers still suspended when the executor is destroyed are abandoned without unwinding their stacks
+        class FiberExecutor final
+        {
+        public:
+            explicit FiberExecutor(std::size_t const numberOfThreads, FiberExecutorOptions const& options = { })
+            {
+                for (std::size_t i = 0; i < std::max<std::size_t>(numberOfThreads, 1u); ++i)
+                {
+                    auto worker = std::make_shared<detail::FiberWorker>(options);
+                    worker->Start();
+                    _workers.emplace_back(std::move(worker));
+                }
+            }
+
+            // waits until all fibers which are not suspended finished
+            ~FiberExecutor()
+            {
+                for (auto& worker : _workers)
+                {
+                    worker->Stop();
+                }
+            }
+
+            FiberExecutor(FiberExecutor const&) = delete;
+            FiberExecutor(FiberExecutor&&) = delete;
+            FiberExecutor& operator=(FiberExecutor const&) = delete;
+            FiberExecutor& operator=(FiberExecutor&&) = delete;
+
+            std::size_t ThreadCount() const noexcept
+            {
+                return _workers.size();
+            }
+
+            template<typename T, typename TResult=std::invoke_result_t<T>>
+            Future<TResult> Execute(T&& callable)
+            {
+                auto newTask = std::make_shared<Task<TResult>>(std::function<TResult()>(std::forward<T>(callable)));
+                auto future = newTask->GetFuture();
+
+                auto const index = _nextWorker.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+                _workers[index]->Schedule(std::make_shared<detail::Fiber>(std::move(newTask)));
+
+                return future;
+            }
+
+            // true if the calling code runs on a fiber (of any fiber executor)
+            static bool RunningInFiber() noexcept
+            {
+                return detail::WaitHook::Current() != nullptr;
+            }
+
+        private:
+            std::vector<std::shared_ptr<detail::FiberWorker>> _workers;
+            std::atomic<std::size_t> _nextWorker{ 0 };
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,753 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <azul/async/Executor.hpp>
+#include <azul/async/Future.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/detail/IoUring.hpp>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        struct IoServiceOptions
+        {
+            // false forces the blocking fallback even if the kernel supports io_uring
+            bool preferIoUring = true;
+            // number of io_uring submission queue entries, operations beyond are queued in user space
+            std::uint32_t queueDepth = 256;
+            // threads of the dedicated pool running blocking syscalls if io_uring is not available
+            std::size_t blockingThreads = 4;
+            // page aligned buffers handed out by IoService::TryAcquireBuffer, registered with the kernel if possible
+            std::size_t registeredBuffers = 0;
+            std::size_t registeredBufferSize = 64 * 1024;
+        };
+
+        namespace detail
+        {
+            enum class IoOperation : std::uint32_t
+            {
+                Read = 0,
+                Write = 1,
+                Fsync = 2
+            };
+
+            struct IoRequest
+            {
+                IoOperation operation = IoOperation::Read;
+                int fd = -1;
+                std::byte* buffer = nullptr;
+                std::uint32_t size = 0;
+                std::uint64_t offset = 0;
+                // index of the registered buffer containing the data, -1 for ordinary memory
+                int bufferIndex = -1;
+                // transferred bytes or -errno
+                std::int64_t result = 0;
+                std::optional<Promise<std::size_t>> transfer;
+                std::optional<Promise<void>> sync;
+
+                void Complete()
+                {
+                    auto const exception = result < 0 ? std::make_exception_ptr(std::system_error(static_cast<int>(-result), std::generic_category())) : nullptr;
+                    if (sync)
+                    {
+                        exception ? sync->SetException(exception) : sync->SetValue();
+                    }
+                    else
+                    {
+                        exception ? transfer->SetException(exception) : transfer->SetValue(static_cast<std::size_t>(result));
+                    }
+                }
+            };
+
+            using IoRequests = std::vector<std::unique_ptr<IoRequest>>;
+
+            // completes the futures inline or, if an executor is given, as a single task on it
+            inline void CompleteIoRequests(std::shared_ptr<Executor> const& executor, IoRequests&& requests)
+            {
+                if (requests.empty())
+                {
+                    return;
+                }
+
+                if (!executor)
+                {
+                    for (auto& request : requests)
+                    {
+                        request->Complete();
+                    }
+                    return;
+                }
+
+                executor->Post([batch = std::make_shared<IoRequests>(std::move(requests))]() {
+                    for (auto& request : *batch)
+                    {
+                        request->Complete();
+                    }
+                });
+            }
+
+            class IoBufferPool final
+            {
+            public:
+                explicit IoBufferPool(std::size_t const count, std::size_t const size)
+                {
+                    auto const pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                    _size = std::max<std::size_t>((size + pageSize - 1) / pageSize * pageSize, pageSize);
+
+                    if (count > 0)
+                    {
+                        _memory = static_cast<std::byte*>(std::aligned_alloc(pageSize, _size * count));
+                        if (!_memory)
+                        {
+                            throw std::bad_alloc();
+                        }
+                    }
+
+                    for (std::size_t i = count; i > 0; --i)
+                    {
+                        _free.push_back(static_cast<std::uint32_t>(i - 1));
+                    }
+                    _count = count;
+                }
+
+                ~IoBufferPool()
+                {
+                    std::free(_memory);
+                }
+
+                IoBufferPool(IoBufferPool const&) = delete;
+                IoBufferPool(IoBufferPool&&) = delete;
+                IoBufferPool& operator=(IoBufferPool const&) = delete;
+                IoBufferPool& operator=(IoBufferPool&&) = delete;
+
+                std::vector<iovec> Buffers() const
+                {
+                    std::vector<iovec> buffers(_count);
+                    for (std::size_t i = 0; i < _count; ++i)
+                    {
+                        buffers[i].iov_base = Data(static_cast<std::uint32_t>(i));
+                        buffers[i].iov_len = _size;
+                    }
+                    return buffers;
+                }
+
+                std::byte* Data(std::uint32_t const index) const noexcept
+                {
+                    return _memory + index * _size;
+                }
+
+                std::size_t Size() const noexcept
+                {
+                    return _size;
+                }
+
+                void MarkRegistered() noexcept
+                {
+                    _registered = true;
+                }
+
+                bool Registered() const noexcept
+                {
+                    return _registered;
+                }
+
+                std::optional<std::uint32_t> TryAcquire()
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (_free.empty())
+                    {
+                        return std::nullopt;
+                    }
+
+                    auto const index = _free.back();
+                    _free.pop_back();
+                    return index;
+                }
+
+                void Release(std::uint32_t const index)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _free.push_back(index);
+                }
+
+            private:
+                std::byte* _memory = nullptr;
+                std::size_t _size = 0;
+                std::size_t _count = 0;
+                bool _registered = false;
+
+                std::mutex _mutex;
+                std::vector<std::uint32_t> _free;
+            };
+
+            class IoBackend
+            {
+            public:
+                virtual ~IoBackend() = default;
+                virtual void Submit(std::unique_ptr<IoRequest>&& request) = 0;
+                virtual bool BuffersRegistered() const noexcept = 0;
+            };
+
+            // a single thread owns the ring: submitters only queue their requests and ring an eventfd
+            // (once per batch), the thread moves all queued requests into the submission queue and submits
+            // them together with a single io_uring_enter, which also waits for the next completions
+            class IoUringBackend final : public IoBackend
+            {
+            public:
+                // the buffers are registered (if possible) before the ring thread blocks in io_uring_enter,
+                // registering them while the ring is in use would wait for the ring to become idle
+                explicit IoUringBackend(std::shared_ptr<Executor> const& executor, std::uint32_t const queueDepth, std::vector<iovec> const& buffers = { })
+                    : _executor(executor)
+                    , _ring(queueDepth)
+                {
+                    // IORING_OP_READ/WRITE appeared together with this feature (linux 5.6)
+                    if ((_ring.Features() & IORING_FEAT_RW_CUR_POS) == 0)
+                    {
+                        throw std::system_error(std::make_error_code(std::errc::function_not_supported));
+                    }
+
+                    _wakeup = ::eventfd(0, EFD_CLOEXEC);
+                    if (_wakeup < 0)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "eventfd");
+                    }
+
+                    // one entry stays reserved for the read of the eventfd, the completion queue is twice as large
+                    _limit = std::max<std::uint32_t>(_ring.Capacity(), 2u) - 1u;
+
+                    _buffersRegistered = !buffers.empty() && _ring.RegisterBuffers(buffers.data(), static_cast<std::uint32_t>(buffers.size()));
+
+                    _thread = std::thread([this]() {
+                        ThreadLoop();
+                    });
+                }
+
+                // waits for all submitted requests
+                ~IoUringBackend() override
+                {
+                    _stopping.store(true, std::memory_order_release);
+                    Signal();
+                    _thread.join();
+                    ::close(_wakeup);
+                }
+
+                IoUringBackend(IoUringBackend const&) = delete;
+                IoUringBackend(IoUringBackend&&) = delete;
+                IoUringBackend& operator=(IoUringBackend const&) = delete;
+                IoUringBackend& operator=(IoUringBackend&&) = delete;
+
+                void Submit(std::unique_ptr<IoRequest>&& request) override
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _queue.push_back(std::move(request));
+                    }
+
+                    if (!_signalled.exchange(true, std::memory_order_acq_rel))
+                    {
+                        Signal();
+                    }
+                }
+
+                bool BuffersRegistered() const noexcept override
+                {
+                    return _buffersRegistered;
+                }
+
+            private:
+                std::shared_ptr<Executor> const _executor;
+                IoUring _ring;
+                int _wakeup = -1;
+                std::uint32_t _limit = 0;
+                bool _buffersRegistered = false;
+
+                std::mutex _mutex;
+                std::vector<std::unique_ptr<IoRequest>> _queue;
+                std::atomic<bool> _signalled{ false };
+                std::atomic<bool> _stopping{ false };
+
+                // only accessed by the ring thread
+                std::deque<std::unique_ptr<IoRequest>> _backlog;
+                std::uint32_t _inFlight = 0;
+                std::uint64_t _wakeupValue = 0;
+
+                std::thread _thread;
+
+                void Signal()
+                {
+                    std::uint64_t const value = 1;
+                    while (::write(_wakeup, &value, sizeof(value)) < 0 && errno == EINTR)
+                    {
+                    }
+                }
+
+                void ArmWakeup()
+                {
+                    auto* sqe = _ring.TryGetSqe();
+                    sqe->opcode = IORING_OP_READ;
+                    sqe->fd = _wakeup;
+                    sqe->addr = reinterpret_cast<std::uintptr_t>(&_wakeupValue);
+                    sqe->len = sizeof(_wakeupValue);
+                    sqe->user_data = 0;
+                }
+
+                std::uint32_t FillSubmissionQueue()
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        for (auto& request : _queue)
+                        {
+                            _backlog.push_back(std::move(request));
+                        }
+                        _queue.clear();
+                    }
+
+                    std::uint32_t prepared = 0;
+                    while (!_backlog.empty() && _inFlight < _limit)
+                    {
+                        auto* sqe = _ring.TryGetSqe();
+                        if (!sqe)
+                        {
+                            break;
+                        }
+
+                        auto* request = _backlog.front().release();
+                        _backlog.pop_front();
+                        Prepare(*sqe, *request);
+
+                        ++_inFlight;
+                        ++prepared;
+                    }
+                    return prepared;
+                }
+
+                static void Prepare(io_uring_sqe& sqe, IoRequest& request)
+                {
+                    sqe.fd = request.fd;
+                    sqe.user_data = reinterpret_cast<std::uintptr_t>(&request);
+
+                    if (request.operation == IoOperation::Fsync)
+                    {
+                        sqe.opcode = IORING_OP_FSYNC;
+                        return;
+                    }
+
+                    bool const fixed = request.bufferIndex >= 0;
+                    if (request.operation == IoOperation::Read)
+                    {
+                        sqe.opcode = fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+                    }
+                    else
+                    {
+                        sqe.opcode = fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+                    }
+
+                    sqe.addr = reinterpret_cast<std::uintptr_t>(request.buffer);
+                    sqe.len = request.size;
+                    sqe.off = request.offset;
+                    sqe.buf_index = fixed ? static_cast<std::uint16_t>(request.bufferIndex) : 0;
+                }
+
+                void ThreadLoop()
+                {
+                    ArmWakeup();
+                    std::uint32_t toSubmit = 1;
+                    IoRequests completed;
+
+                    for (;;)
+                    {
+                        toSubmit += FillSubmissionQueue();
+
+                        if (_stopping.load(std::memory_order_acquire) && _inFlight == 0 && _backlog.empty())
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            if (_queue.empty())
+                            {
+                                break;
+                            }
+                            continue;
+                        }
+
+                        auto const submitted = _ring.Enter(toSubmit, 1);
+                        if (submitted > 0)
+                        {
+                            toSubmit -= static_cast<std::uint32_t>(submitted);
+                        }
+
+                        _ring.ForEachCompletion([this, &toSubmit, &completed](io_uring_cqe const& cqe) {
+                            if (cqe.user_data == 0)
+                            {
+                                // requests queued from now on ring the eventfd again
+                                _signalled.store(false, std::memory_order_release);
+                                ArmWakeup();
+                                ++toSubmit;
+                                return;
+                            }
+
+                            auto request = std::unique_ptr<IoRequest>(reinterpret_cast<IoRequest*>(static_cast<std::uintptr_t>(cqe.user_data)));
+                            request->result = cqe.res;
+                            completed.push_back(std::move(request));
+                            --_inFlight;
+                        });
+
+                        CompleteIoRequests(_executor, std::move(completed));
+                        completed.clear();
+                    }
+                }
+            };
+
+            // runs the blocking syscalls on a dedicated pool, compute workers are never blocked by them
+            class BlockingIoBackend final : public IoBackend
+            {
+            public:
+                explicit BlockingIoBackend(std::shared_ptr<Executor> const& executor, std::size_t const threads)
+                    : _executor(executor)
+                    , _pool(std::make_unique<StaticThreadPool>(std::max<std::size_t>(threads, 1u)))
+                {
+
+                }
+
+                // waits for all submitted requests
+                ~BlockingIoBackend() override
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _idle.wait(lock, [this]() { return _inFlight == 0; });
+                    lock.unlock();
+
+                    _pool.reset();
+                }
+
+                BlockingIoBackend(BlockingIoBackend const&) = delete;
+                BlockingIoBackend(BlockingIoBackend&&) = delete;
+                BlockingIoBackend& operator=(BlockingIoBackend const&) = delete;
+                BlockingIoBackend& operator=(BlockingIoBackend&&) = delete;
+
+                void Submit(std::unique_ptr<IoRequest>&& request) override
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        ++_inFlight;
+                    }
+
+                    _pool->Execute([this, shared = std::shared_ptr<IoRequest>(std::move(request))]() {
+                        Run(*shared);
+
+                        IoRequests completed;
+                        completed.push_back(std::make_unique<IoRequest>(std::move(*shared)));
+                        CompleteIoRequests(_executor, std::move(completed));
+
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        if (--_inFlight == 0)
+                        {
+                            _idle.notify_all();
+                        }
+                    });
+                }
+
+                bool BuffersRegistered() const noexcept override
+                {
+                    return false;
+                }
+
+            private:
+                std::shared_ptr<Executor> const _executor;
+                std::unique_ptr<StaticThreadPool> _pool;
+
+                std::mutex _mutex;
+                std::condition_variable _idle;
+                std::size_t _inFlight = 0;
+
+                static void Run(IoRequest& request)
+                {
+                    ssize_t result = 0;
+                    do
+                    {
+                        switch (request.operation)
+                        {
+                            case IoOperation::Read:
+                                result = ::pread(request.fd, request.buffer, request.size, static_cast<off_t>(request.offset));
+                                break;
+                            case IoOperation::Write:
+                                result = ::pwrite(request.fd, request.buffer, request.size, static_cast<off_t>(request.offset));
+                                break;
+                            case IoOperation::Fsync:
+                                result = ::fsync(request.fd);
+                                break;
+                        }
+                    } while (result < 0 && errno == EINTR);
+
+                    request.result = result < 0 ? -static_cast<std::int64_t>(errno) : static_cast<std::int64_t>(result);
+                }
+            };
+        }
+
+        // lease of one of the buffers preallocated by an io service, returned to the service on destruction
+        // reads and writes through a registered buffer skip the per operation page pinning of the kernel
+        class IoBuffer final
+        {
+        public:
+            explicit IoBuffer(std::shared_ptr<detail::IoBufferPool> const& pool, std::uint32_t const index)
+                : _pool(pool)
+                , _index(index)
+            {
+
+            }
+
+            ~IoBuffer()
+            {
+                if (_pool)
+                {
+                    _pool->Release(_index);
+                }
+            }
+
+            IoBuffer(IoBuffer const&) = delete;
+            IoBuffer& operator=(IoBuffer const&) = delete;
+
+            IoBuffer(IoBuffer&& other) noexcept
+                : _pool(std::move(other._pool))
+                , _index(other._index)
+            {
+
+            }
+
+            IoBuffer& operator=(IoBuffer&& other) noexcept
+            {
+                std::swap(_pool, other._pool);
+                std::swap(_index, other._index);
+                return *this;
+            }
+
+            std::byte* Data() const noexcept
+            {
+                return _pool->Data(_index);
+            }
+
+            std::size_t Size() const noexcept
+            {
+                return _pool->Size();
+            }
+
+            // index of the buffer registered with the kernel, -1 if registration was not possible
+            int RegisteredIndex() const noexcept
+            {
+                return _pool->Registered() ? static_cast<int>(_index) : -1;
+            }
+
+        private:
+            std::shared_ptr<detail::IoBufferPool> _pool;
+            std::uint32_t _index = 0;
+        };
+
+        // executes file operations asynchronously, with io_uring if the kernel supports it and otherwise on a
+        // dedicated pool of threads running the blocking syscalls, completions run on the given executor or inline
+        // destroying the service waits until all submitted operations completed
+        class IoService final
+        {
+        public:
+            explicit IoService(std::shared_ptr<Executor> const& executor = nullptr, IoServiceOptions const& options = { })
+                : _buffers(std::make_shared<detail::IoBufferPool>(options.registeredBuffers, options.registeredBufferSize))
+            {
+                if (options.preferIoUring)
+                {
+                    try
+                    {
+                        _backend = std::make_unique<detail::IoUringBackend>(executor, options.queueDepth, _buffers->Buffers());
+                        _usesIoUring = true;
+                    }
+                    catch (std::system_error const&)
+                    {
+                        // not supported by the kernel or disabled (e.g. by a seccomp profile)
+                    }
+                }
+
+                if (!_backend)
+                {
+                    _backend = std::make_unique<detail::BlockingIoBackend>(executor, options.blockingThreads);
+                }
+
+                if (_backend->BuffersRegistered())
+                {
+                    _buffers->MarkRegistered();
+                }
+            }
+
+            IoService(IoService const&) = delete;
+            IoService(IoService&&) = delete;
+            IoService& operator=(IoService const&) = delete;
+            IoService& operator=(IoService&&) = delete;
+
+            bool UsesIoUring() const noexcept
+            {
+                return _usesIoUring;
+            }
+
+            std::optional<IoBuffer> TryAcquireBuffer()
+            {
+                auto const index = _buffers->TryAcquire();
+                if (!index)
+                {
+                    return std::nullopt;
+                }
+                return std::optional<IoBuffer>(std::in_place, _buffers, *index);
+            }
+
+            void Submit(std::unique_ptr<detail::IoRequest>&& request)
+            {
+                _backend->Submit(std::move(request));
+            }
+
+        private:
+            std::shared_ptr<detail::IoBufferPool> _buffers;
+            std::unique_ptr<detail::IoBackend> _backend;
+            bool _usesIoUring = false;
+        };
+
+        // file with positional asynchronous reads and writes, reads and writes may transfer fewer bytes than
+        // requested (like pread/pwrite), buffers have to stay valid until the future of the operation is ready
+        class File final
+        {
+        public:
+            // takes ownership of the descriptor
+            explicit File(std::shared_ptr<IoService> const& service, int const fd)
+                : _service(service)
+                , _fd(fd)
+            {
+                if (!_service)
+                {
+                    throw std::invalid_argument("The io service must not be null.");
+                }
+            }
+
+            static File Open(std::shared_ptr<IoService> const& service, std::string const& path, int const flags, mode_t const mode = 0644)
+            {
+                auto const fd = ::open(path.c_str(), flags | O_CLOEXEC, mode);
+                if (fd < 0)
+                {
+                    throw std::system_error(errno, std::generic_category(), path);
+                }
+                return File(service, fd);
+            }
+
+            // operations still running keep using the closed descriptor, wait for them first
+            ~File()
+            {
+                if (_fd >= 0)
+                {
+                    ::close(_fd);
+                }
+            }
+
+            File(File const&) = delete;
+            File& operator=(File const&) = delete;
+
+            File(File&& other) noexcept
+                : _service(std::move(other._service))
+                , _fd(std::exchange(other._fd, -1))
+            {
+
+            }
+
+            File& operator=(File&& other) noexcept
+            {
+                std::swap(_service, other._service);
+                std::swap(_fd, other._fd);
+                return *this;
+            }
+
+            int Descriptor() const noexcept
+            {
+                return _fd;
+            }
+
+            Future<std::size_t> ReadAt(void* buffer, std::size_t const size, std::uint64_t const offset)
+            {
+                return Transfer(detail::IoOperation::Read, buffer, size, offset, -1);
+            }
+
+            Future<std::size_t> ReadAt(IoBuffer& buffer, std::size_t const size, std::uint64_t const offset)
+            {
+                return Transfer(detail::IoOperation::Read, buffer.Data(), std::min(size, buffer.Size()), offset, buffer.RegisteredIndex());
+            }
+
+            Future<std::size_t> WriteAt(void const* buffer, std::size_t const size, std::uint64_t const offset)
+            {
+                return Transfer(detail::IoOperation::Write, const_cast<void*>(buffer), size, offset, -1);
+            }
+
+            Future<std::size_t> WriteAt(IoBuffer const& buffer, std::size_t const size, std::uint64_t const offset)
+            {
+                return Transfer(detail::IoOperation::Write, buffer.Data(), std::min(size, buffer.Size()), offset, buffer.RegisteredIndex());
+            }
+
+            Future<void> Fsync()
+            {
+                Check();
+
+                auto request = std::make_unique<detail::IoRequest>();
+                request->operation = detail::IoOperation::Fsync;
+                request->fd = _fd;
+                request->sync.emplace();
+                auto future = request->sync->GetFuture();
+
+                _service->Submit(std::move(request));
+                return future;
+            }
+
+        private:
+            std::shared_ptr<IoService> _service;
+            int _fd = -1;
+
+            void Check() const
+            {
+                if (_fd < 0)
+                {
+                    throw std::logic_error("Calling operations on an uninitialized object.");
+                }
+            }
+
+            Future<std::size_t> Transfer(detail::IoOperation const operation, void* buffer, std::size_t const size, std::uint64_t const offset, int const bufferIndex)
+            {
+                Check();
+
+                auto request = std::make_unique<detail::IoRequest>();
+                request->operation = operation;
+                request->fd = _fd;
+                request->buffer = static_cast<std::byte*>(buffer);
+                request->size = static_cast<std::uint32_t>(std::min<std::size_t>(size, std::numeric_limits<std::int32_t>::max()));
+                request->offset = offset;
+                request->bufferIndex = bufferIndex;
+                request->transfer.emplace();
+                auto future = request->transfer->GetFuture();
+
+                _service->Submit(std::move(request));
+                return future;
+            }
+        };
+    }
+}
+
+#endif
@@ -2,10 +2,14 @@
 
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <azul/async/Executor.hpp>
 #include <azul/async/detail/FutureState.hpp>
 #include <azul/utils/Disposer.hpp>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
 
@@ -13,9 +17,146 @@ namespace azul
 {
     namespace async
     {   
+        template <typename T>
+        class Future;
+
+        namespace detail
+        {
+            // continuations returning a future are flattened: Then yields Future<U> instead of Future<Future<U>>
+            template <typename T>
+            struct UnwrapFuture
+            {
+                using type = T;
+                static constexpr bool value = false;
+            };
+
+            template <typename T>
+            struct UnwrapFuture<Future<T>>
+            {
+                using type = T;
+                static constexpr bool value = true;
+            };
+
+            template <typename T>
+            using UnwrapFutureT = typename UnwrapFuture<T>::type;
+
+            template <typename... TArgs>
+            struct StartsWithAllocatorArg : std::false_type
+            {
+            };
+
+            template <typename TFirst, typename... TArgs>
+            struct StartsWithAllocatorArg<TFirst, TArgs...> : std::is_same<std::decay_t<TFirst>, std::allocator_arg_t>
+            {
+            };
+
+            // source is either a future state or a future
+            template <typename TSource, typename T>
+            void ForwardResult(TSource& source, FutureState<T>& target)
+            {
+                try
+                {
+                    if constexpr (std::is_void_v<T>)
+                    {
+                        source.Get();
+                        target.SetValue();
+                    }
+                    else
+                    {
+                        target.SetValue(source.Get());
+                    }
+                }
+                catch(...)
+                {
+                    target.SetException(std::current_exception());
+                }
+            }
+
+            // result of a future which was already completed on creation,
+            // stored inline in the future without any allocation or synchronization
+            template <typename T>
+            class ReadyState final
+            {
+            public:
+                ReadyState() = default;
+
+                static ReadyState FromValue(T value)
+                {
+                    ReadyState result;
+                    result._value.emplace(std::move(value));
+                    return result;
+                }
+
+                static ReadyState FromException(std::exception_ptr const& ex)
+                {
+                    ReadyState result;
+                    result._exception = ex;
+                    return result;
+                }
+
+                bool Valid() const noexcept
+                {
+                    return _value.has_value() || static_cast<bool>(_exception);
+                }
+
+                T Get() const
+                {
+                    if (_exception)
+                    {
+                        std::rethrow_exception(_exception);
+                    }
+                    return *_value;
+                }
+
+            private:
+                std::optional<T> _value{ };
+                std::exception_ptr _exception{ };
+            };
+
+            template <>
+            class ReadyState<void> final
+            {
+            public:
+                ReadyState() = default;
+
+                static ReadyState FromValue()
+                {
+                    ReadyState result;
+                    result._ready = true;
+                    return result;
+                }
+
+                static ReadyState FromException(std::exception_ptr const& ex)
+                {
+                    ReadyState result;
+                    result._exception = ex;
+                    return result;
+                }
+
+                bool Valid() const noexcept
+                {
+                    return _ready || static_cast<bool>(_exception);
+                }
+
+                void Get() const
+                {
+                    if (_exception)
+                    {
+                        std::rethrow_exception(_exception);
+                    }
+                }
+
+            private:
+                bool _ready = false;
+                std::exception_ptr _exception{ };
+            };
+        }
+
         template <typename T>
         class Future final
         {
+            template <typename> friend class Future;
+
         public:
             Future()
                 : _state(nullptr)
@@ -29,6 +170,13 @@ namespace azul
 
             }
 
+            explicit Future(detail::ReadyState<T>&& ready)
+                : _state(nullptr)
+                , _ready(std::move(ready))
+            {
+
+            }
+
             ~Future() noexcept
             {
                 try {
@@ -47,59 +195,99 @@ namespace azul
 
             bool Valid() const noexcept
             {
-                return static_cast<bool>(_state);
+                return static_cast<bool>(_state) || _ready.Valid();
             }
 
             bool IsReady() const
             {
                 Check();
-                return _state->IsReady();
+                return !_state || _state->IsReady();
             }
 
             T Get() const
             {
                 Check();
+                if (!_state)
+                {
+                    return _ready.Get();
+                }
                 return _state->Get();
             }
 
             void Wait() const
             {
                 Check();
-                _state->Wait();
+                if (_state)
+                {
+                    _state->Wait();
+                }
             }
 
             template <class Rep, class Period>
             bool WaitFor(std::chrono::duration<Rep,Period> const& timeoutDuration) const
             {
                 Check();
-                return _state->WaitFor(timeoutDuration);
+                return !_state || _state->WaitFor(timeoutDuration);
             }
 
             template <typename F>
-            typename ::azul::async::Future<std::invoke_result_t<F, Future<T>>> Then(F&& callable)
+            typename ::azul::async::Future<detail::UnwrapFutureT<std::invoke_result_t<F, Future<T>>>> Then(F&& callable)
             {
                 Check();
 
-                using TResult = std::invoke_result_t<F, Future<T>>;
+                using TCallableResult = std::invoke_result_t<F, Future<T>>;
+                using TResult = detail::UnwrapFutureT<TCallableResult>;
+
+                if (!_state)
+                {
+                    return ThenReady<TResult>(callable);
+                }
 
-                auto futureState = std::make_shared<detail::FutureState<TResult>>();
+                // the new state is allocated from the same memory resource as this one
+                auto const resource = _state->Resource();
+                auto futureState = detail::MakeFutureState<TResult>(resource);
 
                 // promise declared further down in this file therefore we cannot yet use it here
                 // this is why  we just create a state with the same behaviour
                 // as the promise would have (the promise calls AboutToDestroyPromise in its destructor)
                 auto futureStateAsPromise = std::shared_ptr<detail::FutureState<TResult>>(futureState.get(), [futureState](auto*){
                     futureState->AboutToDestroyPromise();
-                });
+                }, std::pmr::polymorphic_allocator<std::byte>(resource));
 
                 auto resultFuture = azul::async::Future<TResult>(futureState);
 
                 // when calling AboutToDestoryPromise on the future state instance on which Then was called, this would clean all cotinuations
                 // and by doing so also destroying all "promises" and therefore setting the shared context of the future we return in Then to PromiseBroken
-                auto continuation = [callable = std::function<TResult(azul::async::Future<T>)>(callable), promise=std::move(futureStateAsPromise), copyOfThis = azul::async::Future<T>(*this)]()
+                auto continuation = [callable = std::function<TCallableResult(azul::async::Future<T>)>(callable), promise=std::move(futureStateAsPromise), copyOfThis = azul::async::Future<T>(*this)]() mutable
                 {
+                    if (!promise)
+                    {
+                        return;
+                    }
+
                     try
                     {
-                        if constexpr (std::is_void_v<TResult>)
+                        if constexpr (detail::UnwrapFuture<TCallableResult>::value)
+                        {
+                            auto innerFuture = callable(copyOfThis);
+                            innerFuture.Check();
+
+                            if (!innerFuture._state)
+                            {
+                                detail::ForwardResult(innerFuture, *promise);
+                                return;
+                            }
+
+                            // the inner future completes our state directly, no additional future/continuation hop
+                            // the continuation may run after the last future of the inner state is gone (e.g. queued by the
+                            // trampoline) and therefore owns the state, the cycle is broken once the inner promise is destroyed
+                            // ownership of the promise moves on, so a broken inner promise also breaks our state
+                            auto innerState = innerFuture._state;
+                            innerState->Then([innerState, promise = std::move(promise)]() {
+                                detail::ForwardResult(*innerState, *promise);
+                            });
+                        }
+                        else if constexpr (std::is_void_v<TResult>)
                         {
                             callable(copyOfThis);
                             promise->SetValue();
@@ -121,23 +309,141 @@ namespace azul
                 return resultFuture;
             }
 
+            // same as Then but the callable runs on the given executor instead of the thread completing this future
+            // the returned future is broken if the executor drops the task without running it
+            template <typename F>
+            typename ::azul::async::Future<detail::UnwrapFutureT<std::invoke_result_t<F, Future<T>>>> Then(std::shared_ptr<Executor> const& executor, F&& callable)
+            {
+                Check();
+
+                if (!executor)
+                {
+                    throw std::invalid_argument("The executor must not be null.");
+                }
+
+                using TCallableResult = std::invoke_result_t<F, Future<T>>;
+
+                // like the states created by Then, the state of the scheduled callable uses the resource of this one
+                auto const resource = _state ? _state->Resource() : std::pmr::get_default_resource();
+
+                auto scheduled = Then([executor, resource, callable = std::function<TCallableResult(azul::async::Future<T>)>(std::forward<F>(callable))](azul::async::Future<T> antecedent) {
+                    auto futureState = detail::MakeFutureState<TCallableResult>(resource);
+                    auto futureStateAsPromise = std::shared_ptr<detail::FutureState<TCallableResult>>(futureState.get(), [futureState](auto*){
+                        futureState->AboutToDestroyPromise();
+                    }, std::pmr::polymorphic_allocator<std::byte>(resource));
+
+                    executor->Post([callable, antecedent, promise = std::move(futureStateAsPromise)]() {
+                        try
+                        {
+                            if constexpr (std::is_void_v<TCallableResult>)
+                            {
+                                callable(antecedent);
+                                promise->SetValue();
+                            }
+                            else
+                            {
+                                auto result = callable(antecedent);
+                                promise->SetValue(result);
+                            }
+                        }
+                        catch(...)
+                        {
+                            promise->SetException(std::current_exception());
+                        }
+                    });
+
+                    return azul::async::Future<TCallableResult>(futureState);
+                });
+
+                // a callable returning a future is flattened like in Then
+                if constexpr (detail::UnwrapFuture<TCallableResult>::value)
+                {
+                    return scheduled.Then([](azul::async::Future<TCallableResult> inner) { return inner.Get(); });
+                }
+                else
+                {
+                    return scheduled;
+                }
+            }
+
             std::size_t NumberOfContinuations() const
             {
-                return _state->NumberOfContinuations();
+                return _state ? _state->NumberOfContinuations() : 0u;
             }
 
         private:
             void Check() const
             {
-                if (!_state)
+                if (!Valid())
                 {
                     throw std::logic_error("Calling operations on an uninitialized object.");
                 }
             }
 
+            // a future created ready does not need any state, the callable is invoked directly
+            template <typename TResult, typename F>
+            Future<TResult> ThenReady(F&& callable)
+            {
+                using TCallableResult = std::invoke_result_t<F, Future<T>>;
+
+                try
+                {
+                    if constexpr (detail::UnwrapFuture<TCallableResult>::value)
+                    {
+                        return callable(*this);
+                    }
+                    else if constexpr (std::is_void_v<TResult>)
+                    {
+                        callable(*this);
+                        return Future<TResult>(detail::ReadyState<TResult>::FromValue());
+                    }
+                    else
+                    {
+                        return Future<TResult>(detail::ReadyState<TResult>::FromValue(callable(*this)));
+                    }
+                }
+                catch(...)
+                {
+                    return Future<TResult>(detail::ReadyState<TResult>::FromException(std::current_exception()));
+                }
+            }
+
             std::shared_ptr<detail::FutureState<T>> _state;
+            detail::ReadyState<T> _ready;
         };
 
+        template <typename T>
+        Future<std::decay_t<T>> MakeReadyFuture(T&& value)
+        {
+            return Future<std::decay_t<T>>(detail::ReadyState<std::decay_t<T>>::FromValue(std::forward<T>(value)));
+        }
+
+        inline Future<void> MakeReadyFuture()
+        {
+            return Future<void>(detail::ReadyState<void>::FromValue());
+        }
+
+        // runs the callable on the given executor, works with any scheduler adapted through MakeExecutor
+        template <typename F>
+        Future<detail::UnwrapFutureT<std::invoke_result_t<F>>> Execute(std::shared_ptr<Executor> const& executor, F&& callable)
+        {
+            return MakeReadyFuture().Then(executor, [callable = std::forward<F>(callable)](Future<void>) mutable {
+                return callable();
+            });
+        }
+
+        template <typename T>
+        Future<T> MakeExceptionalFuture(std::exception_ptr const& ex)
+        {
+            return Future<T>(detail::ReadyState<T>::FromException(ex));
+        }
+
+        template <typename T, typename TException, typename std::enable_if<!std::is_same_v<std::decay_t<TException>, std::exception_ptr>>::type* = nullptr>
+        Future<T> MakeExceptionalFuture(TException&& ex)
+        {
+            return Future<T>(detail::ReadyState<T>::FromException(std::make_exception_ptr(std::forward<TException>(ex))));
+        }
+
         template<typename T>
         class Promise final
         {
@@ -148,6 +454,14 @@ namespace azul
 
             }
 
+            // the shared state and all states created by continuations are allocated from the given resource,
+            // which has to outlive them
+            explicit Promise(std::pmr::memory_resource* resource)
+                : _state(detail::MakeFutureState<T>(resource))
+            {
+
+            }
+
             ~Promise() noexcept
             {
                 try {
@@ -201,6 +515,14 @@ namespace azul
                 return _state->NumberOfContinuations();
             }
 
+            // true if neither a future nor a continuation refers to the state any more, nobody could observe a result
+            // (a future cannot be obtained from nothing, the promise itself is the only way to get a new one)
+            bool Abandoned() const
+            {
+                Check();
+                return _state.use_count() == 1 && _state->NumberOfContinuations() == 0;
+            }
+
         private:
             void Check() const
             {
@@ -214,12 +536,12 @@ namespace azul
         };
 
         template <typename... TFutures>
-        Future<void> WhenAll(TFutures&&... futures)
+        Future<void> WhenAll(std::allocator_arg_t, std::pmr::memory_resource* resource, TFutures&&... futures)
         {
-            auto sharedFutureState = std::make_shared<detail::FutureState<void>>();
+            auto sharedFutureState = detail::MakeFutureState<void>(resource);
             auto future = ::azul::async::Future<void>(sharedFutureState);
 
-            auto sharedPromiseActivator = std::make_shared<azul::utils::Disposer>([sharedFutureState]() {
+            auto sharedPromiseActivator = std::allocate_shared<azul::utils::Disposer>(std::pmr::polymorphic_allocator<azul::utils::Disposer>(resource), [sharedFutureState]() {
                 sharedFutureState->SetValue();
             });
 
@@ -232,6 +554,12 @@ namespace azul
             return future;
         }
 
+        template <typename... TFutures, typename std::enable_if<!detail::StartsWithAllocatorArg<TFutures...>::value>::type* = nullptr>
+        Future<void> WhenAll(TFutures&&... futures)
+        {
+            return WhenAll(std::allocator_arg, std::pmr::get_default_resource(), std::forward<TFutures>(futures)...);
+        }
+
         template <typename... TFutures>
         Future<void> WhenAny(TFutures&&... futures)
         {
@@ -246,6 +574,32 @@ namespace azul
             return future;
         }
 
+        namespace detail
+        {
+            // invokes the (non throwing) handler with the exception of the future if it fails, e.g. because a bounded
+            // executor rejected the task behind it or dropped it later on
+            // a broken promise drops the continuation without invoking it, the disposer reports that case
+            template <typename T, typename F>
+            void OnFailure(Future<T> future, F const& handler)
+            {
+                auto broken = std::make_shared<azul::utils::Disposer>([handler]() {
+                    handler(std::make_exception_ptr(FutureError(FutureErrorCode::BrokenPromise)));
+                });
+
+                future.Then([handler, broken](Future<T> completed) {
+                    broken->Set(nullptr);
+                    try
+                    {
+                        completed.Get();
+                    }
+                    catch (...)
+                    {
+                        handler(std::current_exception());
+                    }
+                });
+            }
+        }
+
         template <typename F1, typename F2>
         static Future<void> operator&&(F1&& future1, F2&& future2)
         {
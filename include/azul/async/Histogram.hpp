@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        // HDR style layout: values below 2^subBucketBits have a bucket each, every following power of two range
+        // [2^e, 2^(e+1)) is split into 2^subBucketBits linear sub-buckets, the relative error of a bucket bound
+        // is therefore at most 2^-subBucketBits (with zero sub-bucket bits bucket i counts values in [2^(i-1), 2^i))
+        struct HistogramSnapshot
+        {
+            static constexpr std::uint32_t MaxSubBucketBits = 16;
+
+            std::uint64_t count = 0;
+            std::uint64_t sum = 0;
+            std::uint64_t min = 0;
+            std::uint64_t max = 0;
+            std::uint32_t subBucketBits = 0;
+            std::vector<std::uint64_t> buckets;
+
+            static std::size_t NumberOfBuckets(std::uint32_t const subBucketBits) noexcept
+            {
+                return (65 - subBucketBits) * (std::size_t{ 1 } << subBucketBits);
+            }
+
+            static std::size_t BucketOf(std::uint64_t const value, std::uint32_t const subBucketBits) noexcept
+            {
+                auto const subBuckets = std::uint64_t{ 1 } << subBucketBits;
+                if (value < subBuckets)
+                {
+                    return static_cast<std::size_t>(value);
+                }
+
+                std::uint32_t exponent = 0;
+                for (auto remaining = value >> 1; remaining != 0; remaining >>= 1)
+                {
+                    ++exponent;
+                }
+
+                auto const subBucket = (value >> (exponent - subBucketBits)) - subBuckets;
+                return static_cast<std::size_t>(subBuckets + (exponent - subBucketBits) * subBuckets + subBucket);
+            }
+
+            // largest value counted by the given bucket
+            std::uint64_t UpperBoundOf(std::size_t const bucket) const noexcept
+            {
+                auto const subBuckets = std::size_t{ 1 } << subBucketBits;
+                if (bucket < subBuckets)
+                {
+                    return bucket;
+                }
+
+                auto const shift = static_cast<std::uint32_t>((bucket - subBuckets) / subBuckets);
+                auto const subBucket = (bucket - subBuckets) % subBuckets;
+                auto const lowerBound = static_cast<std::uint64_t>(subBuckets + subBucket) << shift;
+                return lowerBound + ((std::uint64_t{ 1 } << shift) - 1);
+            }
+
+            double Mean() const noexcept
+            {
+                return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+            }
+
+            // upper bound of the bucket containing the given percentile (0..100)
+            std::uint64_t Percentile(double const percentile) const noexcept
+            {
+                if (count == 0)
+                {
+                    return 0;
+                }
+
+                auto const rank = std::max<std::uint64_t>(1u, static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(count) + 0.5));
+                std::uint64_t seen = 0;
+                for (std::size_t i = 0; i < buckets.size(); ++i)
+                {
+                    seen += buckets[i];
+                    if (seen >= rank)
+                    {
+                        return std::min(UpperBoundOf(i), max);
+                    }
+                }
+                return max;
+            }
+        };
+
+        // lock-free histogram with logarithmic buckets (see HistogramSnapshot for the layout),
+        // recording is wait-free apart from min/max updates
+        class Histogram final
+        {
+        public:
+            // each additional sub-bucket bit halves the relative error and doubles the number of buckets
+            explicit Histogram(std::uint32_t const subBucketBits = 0)
+                : _subBucketBits(subBucketBits)
+            {
+                if (subBucketBits > HistogramSnapshot::MaxSubBucketBits)
+                {
+                    throw std::invalid_argument("Too many sub-bucket bits.");
+                }
+
+                _buckets = std::make_unique<std::atomic<std::uint64_t>[]>(HistogramSnapshot::NumberOfBuckets(subBucketBits));
+            }
+
+            Histogram(Histogram const&) = delete;
+            Histogram(Histogram&&) = delete;
+            Histogram& operator=(Histogram const&) = delete;
+            Histogram& operator=(Histogram&&) = delete;
+
+            void Record(std::uint64_t const value) noexcept
+            {
+                _buckets[HistogramSnapshot::BucketOf(value, _subBucketBits)].fetch_add(1, std::memory_order_relaxed);
+                _count.fetch_add(1, std::memory_order_relaxed);
+                _sum.fetch_add(value, std::memory_order_relaxed);
+
+                auto min = _min.load(std::memory_order_relaxed);
+                while (value < min && !_min.compare_exchange_weak(min, value, std::memory_order_relaxed))
+                {
+                }
+
+                auto max = _max.load(std::memory_order_relaxed);
+                while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+                {
+                }
+            }
+
+            // the snapshot is not atomic with respect to concurrent recordings, it allocates the buckets
+            HistogramSnapshot Snapshot() const
+            {
+                HistogramSnapshot snapshot;
+                snapshot.count = _count.load(std::memory_order_relaxed);
+                snapshot.sum = _sum.load(std::memory_order_relaxed);
+                snapshot.min = snapshot.count == 0 ? 0 : _min.load(std::memory_order_relaxed);
+                snapshot.max = _max.load(std::memory_order_relaxed);
+                snapshot.subBucketBits = _subBucketBits;
+                snapshot.buckets.resize(HistogramSnapshot::NumberOfBuckets(_subBucketBits));
+                for (std::size_t i = 0; i < snapshot.buckets.size(); ++i)
+                {
+                    snapshot.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+                }
+                return snapshot;
+            }
+
+        private:
+            std::uint32_t const _subBucketBits;
+            std::unique_ptr<std::atomic<std::uint64_t>[]> _buckets;
+            std::atomic<std::uint64_t> _count{ 0 };
+            std::atomic<std::uint64_t> _sum{ 0 };
+            std::atomic<std::uint64_t> _min{ std::numeric_limits<std::uint64_t>::max() };
+            std::atomic<std::uint64_t> _max{ 0 };
+        };
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <stdexcept>
+
+namespace azul
+{
+    namespace async
+    {
+        // single use countdown, all futures returned by Wait become ready once the count reaches zero
+        class Latch final
+        {
+        public:
+            explicit Latch(std::size_t const count)
+                : _count(count)
+                , _future(_promise.GetFuture())
+            {
+                if (count == 0)
+                {
+                    _promise.SetValue();
+                }
+            }
+
+            Latch(Latch const&) = delete;
+            Latch(Latch&&) = delete;
+            Latch& operator=(Latch const&) = delete;
+            Latch& operator=(Latch&&) = delete;
+
+            void CountDown(std::size_t const n = 1)
+            {
+                // the count is only modified if it does not drop below zero
+                auto previous = _count.load(std::memory_order_acquire);
+                do
+                {
+                    if (previous < n)
+                    {
+                        throw std::logic_error("Latch counted down below zero.");
+                    }
+                } while (!_count.compare_exchange_weak(previous, previous - n, std::memory_order_acq_rel, std::memory_order_acquire));
+
+                if (previous == n)
+                {
+                    _promise.SetValue();
+                }
+            }
+
+            Future<void> Wait() const
+            {
+                return _future;
+            }
+
+            bool TryWait() const noexcept
+            {
+                return _count.load(std::memory_order_acquire) == 0;
+            }
+
+        private:
+            std::atomic<std::size_t> _count;
+            Promise<void> _promise;
+            Future<void> _future;
+        };
+    }
+}
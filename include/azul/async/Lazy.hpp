@@ -0,0 +1,770 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <azul/utils/Disposer.hpp>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Lazy, statically typed pipelines in the style of the sender/receiver proposal (P2300).
+//
+// A sender only describes work. Connecting it to a receiver produces an operation state which
+// contains the whole pipeline as one object, nothing runs (and nothing is allocated) until Start is called.
+// Stages which run inline are fused into a single call chain.
+//
+//   auto result = lazy::SyncWait(lazy::Just(20) | lazy::Then([](int v){ return v + 1; }) | lazy::On(pool) | lazy::Then([](int v){ return v * 2; }));
+//
+// Receivers provide SetValue(value) (or SetValue() for void) and SetError(std::exception_ptr).
+// Operation states are neither copyable nor movable, their address stays stable until they complete.
+namespace azul
+{
+    namespace async
+    {
+        namespace lazy
+        {
+            namespace detail
+            {
+                template <typename F, typename T>
+                struct InvokeResult
+                {
+                    using type = std::invoke_result_t<F, T>;
+                };
+
+                template <typename F>
+                struct InvokeResult<F, void>
+                {
+                    using type = std::invoke_result_t<F>;
+                };
+
+                template <typename F, typename T>
+                using InvokeResultT = typename InvokeResult<F, T>::type;
+
+                template <typename TSender, typename TReceiver>
+                using OperationT = decltype(std::declval<TSender>().Connect(std::declval<TReceiver>()));
+
+                // storage for a value which may be void
+                template <typename T>
+                struct ValueStorage
+                {
+                    std::optional<T> value{ };
+
+                    template <typename... TArgs>
+                    void Set(TArgs&&... args)
+                    {
+                        value.emplace(std::forward<TArgs>(args)...);
+                    }
+
+                    template <typename TReceiver>
+                    void Deliver(TReceiver& receiver)
+                    {
+                        receiver.SetValue(std::move(*value));
+                    }
+
+                    T Take()
+                    {
+                        return std::move(*value);
+                    }
+                };
+
+                template <>
+                struct ValueStorage<void>
+                {
+                    void Set()
+                    {
+                    }
+
+                    template <typename TReceiver>
+                    void Deliver(TReceiver& receiver)
+                    {
+                        receiver.SetValue();
+                    }
+
+                    void Take()
+                    {
+                    }
+                };
+
+                // invokes the callable and passes its result on, exceptions are reported as error
+                template <typename TReceiver, typename F, typename... TArgs>
+                void InvokeAndDeliver(TReceiver& receiver, F& callable, TArgs&&... args)
+                {
+                    using TResult = std::invoke_result_t<F&, TArgs...>;
+
+                    if constexpr (std::is_void_v<TResult>)
+                    {
+                        try
+                        {
+                            callable(std::forward<TArgs>(args)...);
+                        }
+                        catch(...)
+                        {
+                            receiver.SetError(std::current_exception());
+                            return;
+                        }
+                        receiver.SetValue();
+                    }
+                    else
+                    {
+                        std::optional<TResult> result;
+                        try
+                        {
+                            result.emplace(callable(std::forward<TArgs>(args)...));
+                        }
+                        catch(...)
+                        {
+                            receiver.SetError(std::current_exception());
+                            return;
+                        }
+                        receiver.SetValue(std::move(*result));
+                    }
+                }
+
+                template <typename T, typename TReceiver>
+                class JustOperation final
+                {
+                public:
+                    template <typename TValue, typename TR>
+                    JustOperation(TValue&& value, TR&& receiver)
+                        : _value(std::forward<TValue>(value))
+                        , _receiver(std::forward<TR>(receiver))
+                    {
+
+                    }
+
+                    JustOperation(JustOperation const&) = delete;
+                    JustOperation& operator=(JustOperation const&) = delete;
+
+                    void Start() noexcept
+                    {
+                        _receiver.SetValue(std::move(_value));
+                    }
+
+                private:
+                    T _value;
+                    TReceiver _receiver;
+                };
+
+                template <typename TReceiver>
+                class JustVoidOperation final
+                {
+                public:
+                    template <typename TR>
+                    explicit JustVoidOperation(TR&& receiver)
+                        : _receiver(std::forward<TR>(receiver))
+                    {
+
+                    }
+
+                    JustVoidOperation(JustVoidOperation const&) = delete;
+                    JustVoidOperation& operator=(JustVoidOperation const&) = delete;
+
+                    void Start() noexcept
+                    {
+                        _receiver.SetValue();
+                    }
+
+                private:
+                    TReceiver _receiver;
+                };
+
+                template <typename F, typename TReceiver>
+                class ThenReceiver final
+                {
+                public:
+                    template <typename TF, typename TR>
+                    ThenReceiver(TF&& callable, TR&& receiver)
+                        : _callable(std::forward<TF>(callable))
+                        , _receiver(std::forward<TR>(receiver))
+                    {
+
+                    }
+
+                    template <typename... TArgs>
+                    void SetValue(TArgs&&... args)
+                    {
+                        InvokeAndDeliver(_receiver, _callable, std::forward<TArgs>(args)...);
+                    }
+
+                    void SetError(std::exception_ptr const& ex)
+                    {
+                        _receiver.SetError(ex);
+                    }
+
+                private:
+                    F _callable;
+                    TReceiver _receiver;
+                };
+
+                template <typename TOperation>
+                class OnReceiver final
+                {
+                public:
+                    explicit OnReceiver(TOperation* operation)
+                        : _operation(operation)
+                    {
+
+                    }
+
+                    template <typename... TArgs>
+                    void SetValue(TArgs&&... args)
+                    {
+                        _operation->Transfer(std::forward<TArgs>(args)...);
+                    }
+
+                    void SetError(std::exception_ptr const& ex)
+                    {
+                        _operation->TransferError(ex);
+                    }
+
+                private:
+                    TOperation* _operation;
+                };
+
+                template <typename TSender, typename TExecutor, typename TReceiver>
+                class OnOperation final
+                {
+                public:
+                    template <typename TR>
+                    OnOperation(TSender&& sender, TExecutor& executor, TR&& receiver)
+                        : _executor(executor)
+                        , _receiver(std::forward<TR>(receiver))
+                        , _inner(std::move(sender).Connect(OnReceiver<OnOperation>(this)))
+                    {
+
+                    }
+
+                    OnOperation(OnOperation const&) = delete;
+                    OnOperation& operator=(OnOperation const&) = delete;
+
+                    void Start() noexcept
+                    {
+                        _inner.Start();
+                    }
+
+                    template <typename... TArgs>
+                    void Transfer(TArgs&&... args)
+                    {
+                        _value.Set(std::forward<TArgs>(args)...);
+                        Schedule();
+                    }
+
+                    void TransferError(std::exception_ptr const& ex)
+                    {
+                        _error = ex;
+                        Schedule();
+                    }
+
+                private:
+                    using TValue = typename TSender::ValueType;
+
+                    TExecutor& _executor;
+                    TReceiver _receiver;
+                    ValueStorage<TValue> _value;
+                    std::exception_ptr _error{ };
+                    OperationT<TSender, OnReceiver<OnOperation>> _inner;
+
+                    void Schedule()
+                    {
+                        try
+                        {
+                            _executor.Execute([this]() {
+                                if (_error)
+                                {
+                                    _receiver.SetError(_error);
+                                }
+                                else
+                                {
+                                    _value.Deliver(_receiver);
+                                }
+                            });
+                        }
+                        catch(...)
+                        {
+                            _receiver.SetError(std::current_exception());
+                        }
+                    }
+                };
+
+                template <std::size_t Index, typename TOperation>
+                class WhenAllReceiver final
+                {
+                public:
+                    explicit WhenAllReceiver(TOperation* operation)
+                        : _operation(operation)
+                    {
+
+                    }
+
+                    template <typename TValue>
+                    void SetValue(TValue&& value)
+                    {
+                        _operation->template Complete<Index>(std::forward<TValue>(value));
+                    }
+
+                    void SetError(std::exception_ptr const& ex)
+                    {
+                        _operation->CompleteWithError(ex);
+                    }
+
+                private:
+                    TOperation* _operation;
+                };
+
+                // one connected child of a WhenAll operation, used as a base class so that
+                // the non-movable child operations can be constructed in place
+                template <std::size_t Index, typename TSender, typename TOperation>
+                class WhenAllChild
+                {
+                public:
+                    WhenAllChild(TSender&& sender, TOperation* operation)
+                        : _operation(std::move(sender).Connect(WhenAllReceiver<Index, TOperation>(operation)))
+                    {
+
+                    }
+
+                    void StartChild() noexcept
+                    {
+                        _operation.Start();
+                    }
+
+                private:
+                    OperationT<TSender, WhenAllReceiver<Index, TOperation>> _operation;
+                };
+
+                template <typename TReceiver, typename TIndices, typename... TSenders>
+                class WhenAllOperation;
+
+                template <typename TReceiver, std::size_t... Indices, typename... TSenders>
+                class WhenAllOperation<TReceiver, std::index_sequence<Indices...>, TSenders...> final
+                    : private WhenAllChild<Indices, TSenders, WhenAllOperation<TReceiver, std::index_sequence<Indices...>, TSenders...>>...
+                {
+                public:
+                    template <typename TR>
+                    WhenAllOperation(std::tuple<TSenders...>&& senders, TR&& receiver)
+                        : WhenAllChild<Indices, TSenders, WhenAllOperation>(std::move(std::get<Indices>(senders)), this)...
+                        , _receiver(std::forward<TR>(receiver))
+                    {
+
+                    }
+
+                    WhenAllOperation(WhenAllOperation const&) = delete;
+                    WhenAllOperation& operator=(WhenAllOperation const&) = delete;
+
+                    void Start() noexcept
+                    {
+                        (WhenAllChild<Indices, TSenders, WhenAllOperation>::StartChild(), ...);
+                    }
+
+                    template <std::size_t Index, typename TValue>
+                    void Complete(TValue&& value)
+                    {
+                        std::get<Index>(_values).emplace(std::forward<TValue>(value));
+                        Arrive();
+                    }
+
+                    void CompleteWithError(std::exception_ptr const& ex)
+                    {
+                        if (!_failed.exchange(true, std::memory_order_acq_rel))
+                        {
+                            _error = ex;
+                        }
+                        Arrive();
+                    }
+
+                private:
+                    TReceiver _receiver;
+                    std::tuple<std::optional<typename TSenders::ValueType>...> _values;
+                    std::atomic<std::size_t> _remaining{ sizeof...(TSenders) };
+                    std::atomic<bool> _failed{ false };
+                    std::exception_ptr _error{ };
+
+                    void Arrive()
+                    {
+                        if (_remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                        {
+                            return;
+                        }
+
+                        if (_failed.load(std::memory_order_acquire))
+                        {
+                            _receiver.SetError(_error);
+                        }
+                        else
+                        {
+                            _receiver.SetValue(std::make_tuple(std::move(*std::get<Indices>(_values))...));
+                        }
+                    }
+                };
+
+                template <typename T>
+                class SyncWaitReceiver final
+                {
+                public:
+                    struct State
+                    {
+                        std::mutex mutex;
+                        std::condition_variable condition;
+                        bool done = false;
+                        ValueStorage<T> value;
+                        std::exception_ptr error{ };
+                    };
+
+                    explicit SyncWaitReceiver(State* state)
+                        : _state(state)
+                    {
+
+                    }
+
+                    template <typename... TArgs>
+                    void SetValue(TArgs&&... args)
+                    {
+                        std::lock_guard<std::mutex> lock(_state->mutex);
+                        _state->value.Set(std::forward<TArgs>(args)...);
+                        _state->done = true;
+                        _state->condition.notify_all();
+                    }
+
+                    void SetError(std::exception_ptr const& ex)
+                    {
+                        std::lock_guard<std::mutex> lock(_state->mutex);
+                        _state->error = ex;
+                        _state->done = true;
+                        _state->condition.notify_all();
+                    }
+
+                private:
+                    State* _state;
+                };
+
+                template <typename T, typename TSender>
+                class FutureBridge;
+
+                template <typename T, typename TSender>
+                class FutureBridgeReceiver final
+                {
+                public:
+                    explicit FutureBridgeReceiver(FutureBridge<T, TSender>* bridge)
+                        : _bridge(bridge)
+                    {
+
+                    }
+
+                    template <typename... TArgs>
+                    void SetValue(TArgs&&... args)
+                    {
+                        auto bridge = std::unique_ptr<FutureBridge<T, TSender>>(_bridge);
+                        bridge->promise.SetValue(std::forward<TArgs>(args)...);
+                    }
+
+                    void SetError(std::exception_ptr const& ex)
+                    {
+                        auto bridge = std::unique_ptr<FutureBridge<T, TSender>>(_bridge);
+                        bridge->promise.SetException(ex);
+                    }
+
+                private:
+                    FutureBridge<T, TSender>* _bridge;
+                };
+
+                // the only allocation of a pipeline converted to a future, owns itself until the pipeline completes
+                template <typename T, typename TSender>
+                class FutureBridge final
+                {
+                public:
+                    explicit FutureBridge(TSender&& sender)
+                        : operation(std::move(sender).Connect(FutureBridgeReceiver<T, TSender>(this)))
+                    {
+
+                    }
+
+                    azul::async::Promise<T> promise;
+                    OperationT<TSender, FutureBridgeReceiver<T, TSender>> operation;
+                };
+
+                template <typename T, typename TReceiver>
+                class FromFutureOperation final
+                {
+                public:
+                    template <typename TR>
+                    FromFutureOperation(azul::async::Future<T>&& future, TR&& receiver)
+                        : _future(std::move(future))
+                        , _receiver(std::forward<TR>(receiver))
+                    {
+
+                    }
+
+                    FromFutureOperation(FromFutureOperation const&) = delete;
+                    FromFutureOperation& operator=(FromFutureOperation const&) = delete;
+
+                    void Start() noexcept
+                    {
+                        try
+                        {
+                            // continuations of a broken promise are discarded without being invoked,
+                            // the guard reports the broken promise once the last copy of the continuation is gone
+                            auto brokenPromiseGuard = std::make_shared<azul::utils::Disposer>([this]() {
+                                _receiver.SetError(std::make_exception_ptr(azul::async::FutureError(azul::async::FutureErrorCode::BrokenPromise)));
+                            });
+
+                            _future.Then([this, brokenPromiseGuard](azul::async::Future<T> future) {
+                                brokenPromiseGuard->Set(nullptr);
+
+                                auto forward = [&future]() { return future.Get(); };
+                                InvokeAndDeliver(_receiver, forward);
+                            });
+                        }
+                        catch(...)
+                        {
+                            _receiver.SetError(std::current_exception());
+                        }
+                    }
+
+                private:
+                    azul::async::Future<T> _future;
+                    TReceiver _receiver;
+                };
+            }
+
+            template <typename T>
+            class JustSender final
+            {
+            public:
+                using ValueType = T;
+
+                explicit JustSender(T value)
+                    : _value(std::move(value))
+                {
+
+                }
+
+                template <typename TReceiver>
+                detail::JustOperation<T, std::decay_t<TReceiver>> Connect(TReceiver&& receiver) &&
+                {
+                    return detail::JustOperation<T, std::decay_t<TReceiver>>(std::move(_value), std::forward<TReceiver>(receiver));
+                }
+
+            private:
+                T _value;
+            };
+
+            template <>
+            class JustSender<void> final
+            {
+            public:
+                using ValueType = void;
+
+                template <typename TReceiver>
+                detail::JustVoidOperation<std::decay_t<TReceiver>> Connect(TReceiver&& receiver) &&
+                {
+                    return detail::JustVoidOperation<std::decay_t<TReceiver>>(std::forward<TReceiver>(receiver));
+                }
+            };
+
+            template <typename TSender, typename F>
+            class ThenSender final
+            {
+            public:
+                using ValueType = detail::InvokeResultT<F&, typename TSender::ValueType>;
+
+                ThenSender(TSender sender, F callable)
+                    : _sender(std::move(sender))
+                    , _callable(std::move(callable))
+                {
+
+                }
+
+                template <typename TReceiver>
+                auto Connect(TReceiver&& receiver) &&
+                {
+                    return std::move(_sender).Connect(detail::ThenReceiver<F, std::decay_t<TReceiver>>(std::move(_callable), std::forward<TReceiver>(receiver)));
+                }
+
+            private:
+                TSender _sender;
+                F _callable;
+            };
+
+            template <typename TSender, typename TExecutor>
+            class OnSender final
+            {
+            public:
+                using ValueType = typename TSender::ValueType;
+
+                OnSender(TSender sender, TExecutor& executor)
+                    : _sender(std::move(sender))
+                    , _executor(executor)
+                {
+
+                }
+
+                template <typename TReceiver>
+                detail::OnOperation<TSender, TExecutor, std::decay_t<TReceiver>> Connect(TReceiver&& receiver) &&
+                {
+                    return detail::OnOperation<TSender, TExecutor, std::decay_t<TReceiver>>(std::move(_sender), _executor, std::forward<TReceiver>(receiver));
+                }
+
+            private:
+                TSender _sender;
+                TExecutor& _executor;
+            };
+
+            template <typename... TSenders>
+            class WhenAllSender final
+            {
+            public:
+                static_assert(!(std::is_void_v<typename TSenders::ValueType> || ...), "WhenAll requires senders producing a value.");
+
+                using ValueType = std::tuple<typename TSenders::ValueType...>;
+
+                explicit WhenAllSender(TSenders... senders)
+                    : _senders(std::move(senders)...)
+                {
+
+                }
+
+                template <typename TReceiver>
+                detail::WhenAllOperation<std::decay_t<TReceiver>, std::index_sequence_for<TSenders...>, TSenders...> Connect(TReceiver&& receiver) &&
+                {
+                    return detail::WhenAllOperation<std::decay_t<TReceiver>, std::index_sequence_for<TSenders...>, TSenders...>(std::move(_senders), std::forward<TReceiver>(receiver));
+                }
+
+            private:
+                std::tuple<TSenders...> _senders;
+            };
+
+            template <typename T>
+            class FromFutureSender final
+            {
+            public:
+                using ValueType = T;
+
+                explicit FromFutureSender(azul::async::Future<T> const& future)
+                    : _future(future)
+                {
+
+                }
+
+                template <typename TReceiver>
+                detail::FromFutureOperation<T, std::decay_t<TReceiver>> Connect(TReceiver&& receiver) &&
+                {
+                    return detail::FromFutureOperation<T, std::decay_t<TReceiver>>(std::move(_future), std::forward<TReceiver>(receiver));
+                }
+
+            private:
+                azul::async::Future<T> _future;
+            };
+
+            template <typename F>
+            struct ThenAdapter
+            {
+                F callable;
+            };
+
+            template <typename TExecutor>
+            struct OnAdapter
+            {
+                TExecutor& executor;
+            };
+
+            template <typename T>
+            JustSender<std::decay_t<T>> Just(T&& value)
+            {
+                return JustSender<std::decay_t<T>>(std::forward<T>(value));
+            }
+
+            inline JustSender<void> Just()
+            {
+                return JustSender<void>();
+            }
+
+            template <typename TSender, typename F>
+            ThenSender<std::decay_t<TSender>, std::decay_t<F>> Then(TSender&& sender, F&& callable)
+            {
+                return ThenSender<std::decay_t<TSender>, std::decay_t<F>>(std::forward<TSender>(sender), std::forward<F>(callable));
+            }
+
+            template <typename F>
+            ThenAdapter<std::decay_t<F>> Then(F&& callable)
+            {
+                return ThenAdapter<std::decay_t<F>>{ std::forward<F>(callable) };
+            }
+
+            // all stages after On are executed on the given executor, the executor must outlive the operation
+            template <typename TSender, typename TExecutor>
+            OnSender<std::decay_t<TSender>, TExecutor> On(TSender&& sender, TExecutor& executor)
+            {
+                return OnSender<std::decay_t<TSender>, TExecutor>(std::forward<TSender>(sender), executor);
+            }
+
+            template <typename TExecutor>
+            OnAdapter<TExecutor> On(TExecutor& executor)
+            {
+                return OnAdapter<TExecutor>{ executor };
+            }
+
+            // completes with a tuple of all values once every sender completed, or with the first error
+            template <typename... TSenders>
+            WhenAllSender<std::decay_t<TSenders>...> WhenAll(TSenders&&... senders)
+            {
+                return WhenAllSender<std::decay_t<TSenders>...>(std::forward<TSenders>(senders)...);
+            }
+
+            template <typename T>
+            FromFutureSender<T> FromFuture(azul::async::Future<T> const& future)
+            {
+                return FromFutureSender<T>(future);
+            }
+
+            template <typename TSender, typename F>
+            auto operator|(TSender&& sender, ThenAdapter<F> adapter)
+            {
+                return Then(std::forward<TSender>(sender), std::move(adapter.callable));
+            }
+
+            template <typename TSender, typename TExecutor>
+            auto operator|(TSender&& sender, OnAdapter<TExecutor> adapter)
+            {
+                return On(std::forward<TSender>(sender), adapter.executor);
+            }
+
+            // starts the pipeline and blocks the calling thread until it completes
+            template <typename TSender>
+            typename std::decay_t<TSender>::ValueType SyncWait(TSender&& sender)
+            {
+                using TValue = typename std::decay_t<TSender>::ValueType;
+
+                typename detail::SyncWaitReceiver<TValue>::State state;
+                auto operation = std::decay_t<TSender>(std::forward<TSender>(sender)).Connect(detail::SyncWaitReceiver<TValue>(&state));
+                operation.Start();
+
+                std::unique_lock<std::mutex> lock(state.mutex);
+                state.condition.wait(lock, [&state]() { return state.done; });
+
+                if (state.error)
+                {
+                    std::rethrow_exception(state.error);
+                }
+                return state.value.Take();
+            }
+
+            // starts the pipeline and returns a future for its result (one allocation for the whole pipeline)
+            template <typename TSender>
+            azul::async::Future<typename std::decay_t<TSender>::ValueType> ToFuture(TSender&& sender)
+            {
+                using TValue = typename std::decay_t<TSender>::ValueType;
+
+                auto bridge = new detail::FutureBridge<TValue, std::decay_t<TSender>>(std::decay_t<TSender>(std::forward<TSender>(sender)));
+                auto future = bridge->promise.GetFuture();
+                bridge->operation.Start();
+                return future;
+            }
+        }
+    }
+}
@@ -0,0 +1,437 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        enum class StageMode : std::uint32_t
+        {
+            // processes one item at a time in the order produced by the source
+            SerialInOrder = 0,
+            // processes one item at a time in arrival order
+            SerialOutOfOrder = 1,
+            // processes any number of items concurrently
+            Parallel = 2
+        };
+
+        namespace detail
+        {
+            template <typename T>
+            class PipelineState final : public std::enable_shared_from_this<PipelineState<T>>
+            {
+            public:
+                using Source = std::function<bool(T&)>;
+                using StageFunction = std::function<void(T&)>;
+
+                explicit PipelineState(StaticThreadPool& executor, std::size_t const maxTokens)
+                    : _executor(executor)
+                    , _tokens(std::max<std::size_t>(maxTokens, 1u))
+                {
+                    _free.reserve(_tokens.size());
+                }
+
+                void AddStage(StageMode const mode, StageFunction&& function)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (_running)
+                    {
+                        throw std::logic_error("Stages cannot be added while the pipeline is running.");
+                    }
+
+                    auto stage = std::make_unique<Stage>();
+                    stage->mode = mode;
+                    stage->function = std::move(function);
+                    stage->parked.resize(_tokens.size(), nullptr);
+                    _stages.push_back(std::move(stage));
+                }
+
+                Future<std::size_t> Run(Source&& source)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (_running)
+                    {
+                        throw std::logic_error("The pipeline is already running.");
+                    }
+
+                    _running = true;
+                    _source = std::move(source);
+                    _sourceBusy = false;
+                    _exhausted = false;
+                    _failed.store(false, std::memory_order_relaxed);
+                    _exception = nullptr;
+                    _inFlight = 0;
+                    _processed = 0;
+                    _nextSequence = 0;
+
+                    for (auto& stage : _stages)
+                    {
+                        stage->busy = false;
+                        stage->nextSequence = 0;
+                        stage->head = 0;
+                        stage->count = 0;
+                        std::fill(stage->parked.begin(), stage->parked.end(), nullptr);
+                    }
+
+                    _free.clear();
+                    for (auto& token : _tokens)
+                    {
+                        _free.push_back(&token);
+                    }
+
+                    _promise.emplace();
+                    auto future = _promise->GetFuture();
+                    lock.unlock();
+
+                    Post([self = this->shared_from_this()]() {
+                        self->StartToken();
+                    });
+
+                    return future;
+                }
+
+            private:
+                // a token carries one item through the pipeline, its buffer is reused by the following items
+                struct Token
+                {
+                    T value{ };
+                    std::uint64_t sequence = 0;
+                    bool failed = false;
+                };
+
+                struct Stage
+                {
+                    StageMode mode = StageMode::Parallel;
+                    StageFunction function;
+
+                    std::mutex mutex;
+                    bool busy = false;
+                    std::uint64_t nextSequence = 0;
+                    // tokens waiting for the stage: indexed by sequence for in order stages, a ring buffer otherwise
+                    std::vector<Token*> parked;
+                    std::size_t head = 0;
+                    std::size_t count = 0;
+                };
+
+                StaticThreadPool& _executor;
+                std::vector<Token> _tokens;
+                std::vector<std::unique_ptr<Stage>> _stages;
+
+                std::mutex _mutex;
+                bool _running = false;
+                Source _source;
+                bool _sourceBusy = false;
+                bool _exhausted = false;
+                std::vector<Token*> _free;
+                std::size_t _inFlight = 0;
+                std::size_t _processed = 0;
+                std::uint64_t _nextSequence = 0;
+                std::exception_ptr _exception;
+                std::optional<Promise<std::size_t>> _promise;
+
+                std::atomic<bool> _failed{ false };
+
+                // lets the source fill a free token, the source itself is never invoked concurrently
+                void StartToken()
+                {
+                    Token* token = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        if (_sourceBusy || _exhausted || _free.empty())
+                        {
+                            return;
+                        }
+
+                        _sourceBusy = true;
+                        token = _free.back();
+                        _free.pop_back();
+                        ++_inFlight;
+                    }
+
+                    bool produced = false;
+                    bool more = false;
+                    try
+                    {
+                        produced = !_failed.load(std::memory_order_acquire) && _source(token->value);
+                    }
+                    catch (...)
+                    {
+                        Fail(std::current_exception());
+                    }
+
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _sourceBusy = false;
+
+                        if (!produced)
+                        {
+                            _exhausted = true;
+                            _free.push_back(token);
+                            --_inFlight;
+                            if (_inFlight > 0)
+                            {
+                                return;
+                            }
+                            lock.unlock();
+
+                            Complete();
+                            return;
+                        }
+
+                        token->sequence = _nextSequence++;
+                        token->failed = false;
+                        // without a free token the next item is started by the token finishing first, posting it anyway
+                        // would add a no-op task for every item and eventually overflow a bounded pool
+                        more = !_free.empty();
+                    }
+
+                    // the next item is produced while this one travels through the stages
+                    if (more)
+                    {
+                        Post([self = this->shared_from_this()]() {
+                            self->StartToken();
+                        });
+                    }
+
+                    Advance(token, 0);
+                }
+
+                // runs the stages for the token until it has to wait for a serial stage or leaves the pipeline
+                void Advance(Token* token, std::size_t index)
+                {
+                    for (; index < _stages.size(); ++index)
+                    {
+                        auto& stage = *_stages[index];
+                        if (stage.mode == StageMode::Parallel)
+                        {
+                            Invoke(stage, *token);
+                            continue;
+                        }
+
+                        if (!Enter(stage, token))
+                        {
+                            // the token is resumed by the token currently owning the stage
+                            return;
+                        }
+
+                        Invoke(stage, *token);
+                        Leave(stage, index);
+                    }
+
+                    Finish(token);
+                }
+
+                void Resume(Token* token, std::size_t const index)
+                {
+                    auto& stage = *_stages[index];
+                    Invoke(stage, *token);
+                    Leave(stage, index);
+                    Advance(token, index + 1);
+                }
+
+                bool Enter(Stage& stage, Token* token)
+                {
+                    std::unique_lock<std::mutex> lock(stage.mutex);
+                    if (stage.mode == StageMode::SerialInOrder)
+                    {
+                        if (stage.busy || token->sequence != stage.nextSequence)
+                        {
+                            stage.parked[token->sequence % stage.parked.size()] = token;
+                            return false;
+                        }
+                    }
+                    else if (stage.busy)
+                    {
+                        stage.parked[(stage.head + stage.count) % stage.parked.size()] = token;
+                        ++stage.count;
+                        return false;
+                    }
+
+                    stage.busy = true;
+                    return true;
+                }
+
+                // hands the stage over to the next waiting token (if any), which continues on the pool
+                void Leave(Stage& stage, std::size_t const index)
+                {
+                    Token* next = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lock(stage.mutex);
+                        if (stage.mode == StageMode::SerialInOrder)
+                        {
+                            ++stage.nextSequence;
+                            auto& slot = stage.parked[stage.nextSequence % stage.parked.size()];
+                            if (slot && slot->sequence == stage.nextSequence)
+                            {
+                                next = slot;
+                                slot = nullptr;
+                            }
+                        }
+                        else if (stage.count > 0)
+                        {
+                            next = stage.parked[stage.head];
+                            stage.head = (stage.head + 1) % stage.parked.size();
+                            --stage.count;
+                        }
+
+                        stage.busy = next != nullptr;
+                    }
+
+                    if (next)
+                    {
+                        Post([self = this->shared_from_this(), next, index]() {
+                            self->Resume(next, index);
+                        });
+                    }
+                }
+
+                // failed tokens still pass through all stages (without invoking them) to keep the order of serial stages
+                void Invoke(Stage& stage, Token& token)
+                {
+                    if (token.failed || _failed.load(std::memory_order_acquire))
+                    {
+                        token.failed = true;
+                        return;
+                    }
+
+                    try
+                    {
+                        stage.function(token.value);
+                    }
+                    catch (...)
+                    {
+                        token.failed = true;
+                        Fail(std::current_exception());
+                    }
+                }
+
+                void Finish(Token* token)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        if (!token->failed)
+                        {
+                            ++_processed;
+                        }
+                        _free.push_back(token);
+                        --_inFlight;
+
+                        if (!_exhausted || _inFlight > 0)
+                        {
+                            lock.unlock();
+
+                            // not started inline, which would nest the processing of all following items on this stack
+                            Post([self = this->shared_from_this()]() {
+                                self->StartToken();
+                            });
+                            return;
+                        }
+                    }
+
+                    Complete();
+                }
+
+                // a task rejected or dropped by a bounded pool fails the run, the work then runs on the calling thread
+                // as it only moves the token on (sources and stages are not invoked any more)
+                template <typename F>
+                void Post(F const& work)
+                {
+                    detail::OnFailure(_executor.Execute(work), [weakSelf = this->weak_from_this(), work](std::exception_ptr const& exception) {
+                        if (auto const self = weakSelf.lock())
+                        {
+                            self->Fail(exception);
+                            work();
+                        }
+                    });
+                }
+
+                void Fail(std::exception_ptr const& exception)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (!_exception)
+                    {
+                        _exception = exception;
+                    }
+                    _failed.store(true, std::memory_order_release);
+                }
+
+                void Complete()
+                {
+                    std::optional<Promise<std::size_t>> promise;
+                    std::exception_ptr exception;
+                    std::size_t processed = 0;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        promise.swap(_promise);
+                        exception = _exception;
+                        processed = _processed;
+                        _source = nullptr;
+                        _running = false;
+                    }
+
+                    if (exception)
+                    {
+                        promise->SetException(exception);
+                    }
+                    else
+                    {
+                        promise->SetValue(processed);
+                    }
+                }
+            };
+        }
+
+        // pushes the items produced by a source through a sequence of stages on the thread pool
+        // at most maxTokens items are in flight at any time, their buffers (of type T) are allocated once
+        // and reused, stages transform the item in place
+        template <typename T>
+        class Pipeline final
+        {
+        public:
+            using Source = typename detail::PipelineState<T>::Source;
+            using StageFunction = typename detail::PipelineState<T>::StageFunction;
+
+            explicit Pipeline(std::shared_ptr<StaticThreadPool> const& executor, std::size_t const maxTokens)
+                : _executor(executor)
+                , _state(std::make_shared<detail::PipelineState<T>>(*executor, maxTokens))
+            {
+
+            }
+
+            Pipeline(Pipeline const&) = delete;
+            Pipeline(Pipeline&&) = default;
+            Pipeline& operator=(Pipeline const&) = delete;
+            Pipeline& operator=(Pipeline&&) = default;
+
+            Pipeline& AddStage(StageMode const mode, StageFunction stage)
+            {
+                _state->AddStage(mode, std::move(stage));
+                return *this;
+            }
+
+            // the source fills the given buffer and returns false once the input is exhausted, it is never invoked concurrently
+            // the returned future holds the number of processed items or the first exception thrown by the source or a stage
+            Future<std::size_t> Run(Source source)
+            {
+                return _state->Run(std::move(source));
+            }
+
+        private:
+            // owned here and not by the state, which lives on in the tasks of a running pipeline
+            std::shared_ptr<StaticThreadPool> _executor;
+            std::shared_ptr<detail::PipelineState<T>> _state;
+        };
+    }
+}
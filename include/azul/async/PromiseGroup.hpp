@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <azul/async/Executor.hpp>
+#include <azul/async/Future.hpp>
+#include <azul/async/detail/FutureState.hpp>
+#include <azul/async/detail/Trampoline.hpp>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        // promises completed together, e.g. all requests of a batch
+        // the bulk setters publish every result first and run the continuations afterwards, either inline or
+        // as a single task on the given executor, instead of one dispatch cascade per promise
+        // promises not completed when the group is destroyed report a broken promise
+        template <typename T>
+        class PromiseGroup final
+        {
+        public:
+            explicit PromiseGroup(std::size_t const size = 0, std::shared_ptr<Executor> const& executor = nullptr, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                : _executor(executor)
+                , _resource(resource)
+            {
+                _states.reserve(size);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    _states.emplace_back(detail::MakeFutureState<T>(resource));
+                }
+            }
+
+            ~PromiseGroup() noexcept
+            {
+                try
+                {
+                    for (auto& state : _states)
+                    {
+                        state->AboutToDestroyPromise();
+                    }
+                }
+                catch (...)
+                {
+                }
+            }
+
+            PromiseGroup(PromiseGroup const&) = delete;
+            PromiseGroup(PromiseGroup&&) = default;
+            PromiseGroup& operator=(PromiseGroup const&) = delete;
+
+            // the promises previously owned by this group are broken by the destructor of the other one
+            PromiseGroup& operator=(PromiseGroup&& other) noexcept
+            {
+                std::swap(_executor, other._executor);
+                std::swap(_resource, other._resource);
+                std::swap(_states, other._states);
+                return *this;
+            }
+
+            std::size_t Size() const noexcept
+            {
+                return _states.size();
+            }
+
+            // appends a promise to the group and returns its future
+            Future<T> Add()
+            {
+                _states.emplace_back(detail::MakeFutureState<T>(_resource));
+                return Future<T>(_states.back());
+            }
+
+            Future<T> GetFuture(std::size_t const index) const
+            {
+                return Future<T>(_states.at(index));
+            }
+
+            std::vector<Future<T>> GetFutures() const
+            {
+                std::vector<Future<T>> futures;
+                futures.reserve(_states.size());
+                for (auto const& state : _states)
+                {
+                    futures.emplace_back(state);
+                }
+                return futures;
+            }
+
+            // completes a single promise like Promise::SetValue, its continuations run immediately
+            template <typename F, typename std::enable_if<std::is_same_v<F, T> && !std::is_void_v<F>>::type* = nullptr>
+            void SetValue(std::size_t const index, F const& value)
+            {
+                std::vector<std::function<void()>> continuations;
+                if (!_states.at(index)->TrySetValue(value, continuations))
+                {
+                    throw FutureError(FutureErrorCode::FutureAlreadySet);
+                }
+                RunInline(continuations);
+            }
+
+            template <typename F = void, typename std::enable_if<std::is_void_v<F>>::type* = nullptr>
+            void SetValue(std::size_t const index)
+            {
+                std::vector<std::function<void()>> continuations;
+                if (!_states.at(index)->TrySetValue(continuations))
+                {
+                    throw FutureError(FutureErrorCode::FutureAlreadySet);
+                }
+                RunInline(continuations);
+            }
+
+            void SetException(std::size_t const index, std::exception_ptr const& exception)
+            {
+                std::vector<std::function<void()>> continuations;
+                if (!_states.at(index)->TrySetException(exception, continuations))
+                {
+                    throw FutureError(FutureErrorCode::FutureAlreadySet);
+                }
+                RunInline(continuations);
+            }
+
+            // completes every promise not completed yet with the value at the same position of the range,
+            // the range has to contain one value per promise
+            template <typename TRange, typename F = T, typename std::enable_if<!std::is_void_v<F>>::type* = nullptr>
+            void SetValues(TRange const& values)
+            {
+                if (static_cast<std::size_t>(std::distance(std::begin(values), std::end(values))) != _states.size())
+                {
+                    throw std::invalid_argument("The range has to contain exactly one value per promise.");
+                }
+
+                std::vector<std::function<void()>> continuations;
+                continuations.reserve(_states.size());
+                auto value = std::begin(values);
+                for (auto& state : _states)
+                {
+                    state->TrySetValue(*value, continuations);
+                    ++value;
+                }
+                Run(std::move(continuations));
+            }
+
+            template <typename F = T, typename std::enable_if<std::is_void_v<F>>::type* = nullptr>
+            void SetValues()
+            {
+                std::vector<std::function<void()>> continuations;
+                for (auto& state : _states)
+                {
+                    state->TrySetValue(continuations);
+                }
+                Run(std::move(continuations));
+            }
+
+            // fails every promise not completed yet
+            void SetExceptions(std::exception_ptr const& exception)
+            {
+                std::vector<std::function<void()>> continuations;
+                for (auto& state : _states)
+                {
+                    state->TrySetException(exception, continuations);
+                }
+                Run(std::move(continuations));
+            }
+
+        private:
+            std::shared_ptr<Executor> _executor;
+            std::pmr::memory_resource* _resource;
+            std::vector<std::shared_ptr<detail::FutureState<T>>> _states;
+
+            // the first exception thrown by a continuation is rethrown after all of them ran
+            static void RunInline(std::vector<std::function<void()>> const& continuations)
+            {
+                std::exception_ptr firstException;
+                for (auto const& continuation : continuations)
+                {
+                    try
+                    {
+                        detail::Trampoline::Dispatch(continuation);
+                    }
+                    catch (...)
+                    {
+                        if (!firstException)
+                        {
+                            firstException = std::current_exception();
+                        }
+                    }
+                }
+
+                if (firstException)
+                {
+                    std::rethrow_exception(firstException);
+                }
+            }
+
+            void Run(std::vector<std::function<void()>>&& continuations)
+            {
+                if (continuations.empty())
+                {
+                    return;
+                }
+
+                if (!_executor)
+                {
+                    RunInline(continuations);
+                    return;
+                }
+
+                _executor->Post([batch = std::make_shared<std::vector<std::function<void()>>>(std::move(continuations))]() {
+                    RunInline(*batch);
+                });
+            }
+        };
+    }
+}
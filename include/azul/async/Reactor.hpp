@@ -0,0 +1,475 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <azul/async/Executor.hpp>
+#include <azul/async/Future.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        struct ReactorOptions
+        {
+            // maximum number of events fetched by a single epoll_wait call
+            std::size_t maxEventsPerWait = 256;
+        };
+
+        namespace detail
+        {
+            enum class ReactorOperationKind : std::uint32_t
+            {
+                Wait = 0,
+                Read = 1,
+                Write = 2
+            };
+
+            struct ReactorOperation
+            {
+                ReactorOperationKind kind = ReactorOperationKind::Wait;
+                std::byte* buffer = nullptr;
+                std::size_t size = 0;
+                std::size_t transferred = 0;
+                std::optional<Promise<void>> readiness;
+                std::optional<Promise<std::size_t>> completion;
+            };
+
+            struct ReactorCompletion
+            {
+                ReactorOperation operation;
+                std::exception_ptr exception;
+
+                void operator()()
+                {
+                    if (operation.readiness)
+                    {
+                        exception ? operation.readiness->SetException(exception) : operation.readiness->SetValue();
+                    }
+                    else
+                    {
+                        exception ? operation.completion->SetException(exception) : operation.completion->SetValue(operation.transferred);
+                    }
+                }
+            };
+
+            // pending operations of one file descriptor, one queue per direction processed in submission order
+            struct ReactorDescriptor
+            {
+                explicit ReactorDescriptor(int const descriptor)
+                    : fd(descriptor)
+                {
+
+                }
+
+                int const fd;
+                bool isSocket = true;
+
+                std::mutex mutex;
+                // readiness as reported by the last edge, cleared as soon as a syscall reports EAGAIN
+                bool readable = false;
+                bool writable = false;
+                std::deque<ReactorOperation> readers;
+                std::deque<ReactorOperation> writers;
+            };
+        }
+
+        // drives non-blocking file descriptors (sockets, pipes, ...) from a single thread using edge triggered epoll
+        // reads and writes are attempted directly by the submitting thread while the descriptor is ready and are only
+        // parked until the next edge otherwise, completions run on the given executor or inline (possibly on the reactor thread)
+        // the reactor does not own the descriptors, buffers have to stay valid until the future of the operation is ready
+        class Reactor final
+        {
+        public:
+            explicit Reactor(std::shared_ptr<Executor> const& executor = nullptr, ReactorOptions const& options = { })
+                : _executor(executor)
+                , _options(options)
+            {
+                _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+                if (_epoll < 0)
+                {
+                    throw std::system_error(errno, std::generic_category(), "epoll_create1");
+                }
+
+                _wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                if (_wakeup < 0)
+                {
+                    auto const error = errno;
+                    ::close(_epoll);
+                    throw std::system_error(error, std::generic_category(), "eventfd");
+                }
+
+                epoll_event event{ };
+                event.events = EPOLLIN;
+                event.data.fd = _wakeup;
+                ::epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeup, &event);
+
+                _thread = std::thread([this]() {
+                    ThreadLoop();
+                });
+            }
+
+            explicit Reactor(std::shared_ptr<StaticThreadPool> const& executor, ReactorOptions const& options = { })
+                : Reactor(MakeExecutor(executor), options)
+            {
+
+            }
+
+            // futures of operations still pending report a broken promise
+            ~Reactor()
+            {
+                std::uint64_t const value = 1;
+                while (::write(_wakeup, &value, sizeof(value)) < 0 && errno == EINTR)
+                {
+                }
+
+                _thread.join();
+                _descriptors.clear();
+
+                ::close(_wakeup);
+                ::close(_epoll);
+            }
+
+            Reactor(Reactor const&) = delete;
+            Reactor(Reactor&&) = delete;
+            Reactor& operator=(Reactor const&) = delete;
+            Reactor& operator=(Reactor&&) = delete;
+
+            // switches the descriptor to non-blocking mode and starts watching it
+            void Register(int const fd)
+            {
+                auto const flags = ::fcntl(fd, F_GETFL);
+                if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+                {
+                    throw std::system_error(errno, std::generic_category(), "fcntl");
+                }
+
+                auto descriptor = std::make_shared<detail::ReactorDescriptor>(fd);
+
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (_descriptors.count(fd) > 0)
+                {
+                    throw std::logic_error("The file descriptor is already registered.");
+                }
+
+                epoll_event event{ };
+                event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+                event.data.fd = fd;
+                if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+                {
+                    throw std::system_error(errno, std::generic_category(), "epoll_ctl");
+                }
+
+                _descriptors.emplace(fd, std::move(descriptor));
+            }
+
+            // stops watching the descriptor, pending operations fail with std::errc::operation_canceled
+            void Unregister(int const fd)
+            {
+                std::shared_ptr<detail::ReactorDescriptor> descriptor;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    auto const it = _descriptors.find(fd);
+                    if (it == _descriptors.end())
+                    {
+                        return;
+                    }
+
+                    descriptor = std::move(it->second);
+                    _descriptors.erase(it);
+                    ::epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, nullptr);
+                }
+
+                std::vector<detail::ReactorCompletion> completed;
+                {
+                    std::unique_lock<std::mutex> lock(descriptor->mutex);
+                    auto const cancelled = std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::operation_canceled)));
+                    for (auto* queue : { &descriptor->readers, &descriptor->writers })
+                    {
+                        for (auto& operation : *queue)
+                        {
+                            completed.push_back({ std::move(operation), cancelled });
+                        }
+                        queue->clear();
+                    }
+                }
+
+                Dispatch(std::move(completed));
+            }
+
+            // ready once the descriptor becomes readable (or reached end of file / failed), spurious readiness is possible
+            Future<void> WaitReadable(int const fd)
+            {
+                return Wait(fd, true);
+            }
+
+            Future<void> WaitWritable(int const fd)
+            {
+                return Wait(fd, false);
+            }
+
+            // reads at most size bytes, the future holds the number of bytes read (zero at end of file)
+            Future<std::size_t> Read(int const fd, void* buffer, std::size_t const size)
+            {
+                return Transfer(fd, detail::ReactorOperationKind::Read, buffer, size);
+            }
+
+            // the future is ready once all bytes have been written
+            Future<std::size_t> Write(int const fd, void const* buffer, std::size_t const size)
+            {
+                return Transfer(fd, detail::ReactorOperationKind::Write, const_cast<void*>(buffer), size);
+            }
+
+            std::size_t NumberOfDescriptors() const
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                return _descriptors.size();
+            }
+
+        private:
+            std::shared_ptr<Executor> const _executor;
+            ReactorOptions const _options;
+
+            int _epoll = -1;
+            int _wakeup = -1;
+
+            mutable std::mutex _mutex;
+            std::unordered_map<int, std::shared_ptr<detail::ReactorDescriptor>> _descriptors;
+
+            std::thread _thread;
+
+            std::shared_ptr<detail::ReactorDescriptor> Find(int const fd) const
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                auto const it = _descriptors.find(fd);
+                return it == _descriptors.end() ? nullptr : it->second;
+            }
+
+            Future<void> Wait(int const fd, bool const readable)
+            {
+                detail::ReactorOperation operation;
+                operation.readiness.emplace();
+                auto future = operation.readiness->GetFuture();
+
+                Submit(fd, readable, std::move(operation));
+                return future;
+            }
+
+            Future<std::size_t> Transfer(int const fd, detail::ReactorOperationKind const kind, void* buffer, std::size_t const size)
+            {
+                detail::ReactorOperation operation;
+                operation.kind = kind;
+                operation.buffer = static_cast<std::byte*>(buffer);
+                operation.size = size;
+                operation.completion.emplace();
+                auto future = operation.completion->GetFuture();
+
+                Submit(fd, kind != detail::ReactorOperationKind::Write, std::move(operation));
+                return future;
+            }
+
+            void Submit(int const fd, bool const readDirection, detail::ReactorOperation&& operation)
+            {
+                auto descriptor = Find(fd);
+                if (!descriptor)
+                {
+                    throw std::logic_error("The file descriptor is not registered.");
+                }
+
+                std::vector<detail::ReactorCompletion> completed;
+                {
+                    // the syscalls happen under the lock, an edge arriving in the meantime is handled by the reactor
+                    // thread once the operation is queued and therefore cannot get lost
+                    std::unique_lock<std::mutex> lock(descriptor->mutex);
+                    auto& queue = readDirection ? descriptor->readers : descriptor->writers;
+                    queue.push_back(std::move(operation));
+                    if (queue.size() == 1)
+                    {
+                        Process(*descriptor, readDirection, completed);
+                    }
+                }
+
+                Dispatch(std::move(completed));
+            }
+
+            // runs the queued operations of one direction until the descriptor would block
+            static void Process(detail::ReactorDescriptor& descriptor, bool const readDirection, std::vector<detail::ReactorCompletion>& completed)
+            {
+                auto& queue = readDirection ? descriptor.readers : descriptor.writers;
+                auto& ready = readDirection ? descriptor.readable : descriptor.writable;
+
+                while (ready && !queue.empty())
+                {
+                    auto& operation = queue.front();
+                    std::exception_ptr exception;
+                    if (!Attempt(descriptor, operation, ready, exception))
+                    {
+                        break;
+                    }
+
+                    completed.push_back({ std::move(operation), exception });
+                    queue.pop_front();
+                }
+            }
+
+            // false if the operation has to wait for the next edge
+            static bool Attempt(detail::ReactorDescriptor& descriptor, detail::ReactorOperation& operation, bool& ready, std::exception_ptr& exception)
+            {
+                for (;;)
+                {
+                    ssize_t result = 0;
+                    switch (operation.kind)
+                    {
+                        case detail::ReactorOperationKind::Wait:
+                            return true;
+
+                        case detail::ReactorOperationKind::Read:
+                            result = ::read(descriptor.fd, operation.buffer, operation.size);
+                            break;
+
+                        case detail::ReactorOperationKind::Write:
+                            if (operation.transferred == operation.size)
+                            {
+                                return true;
+                            }
+                            result = WriteSome(descriptor, operation.buffer + operation.transferred, operation.size - operation.transferred);
+                            break;
+                    }
+
+                    if (result >= 0)
+                    {
+                        operation.transferred += static_cast<std::size_t>(result);
+                        if (operation.kind == detail::ReactorOperationKind::Read)
+                        {
+                            return true;
+                        }
+                        continue;
+                    }
+
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    {
+                        ready = false;
+                        return false;
+                    }
+
+                    exception = std::make_exception_ptr(std::system_error(errno, std::generic_category()));
+                    return true;
+                }
+            }
+
+            // sockets are written with MSG_NOSIGNAL, a closed peer then fails the write with EPIPE instead of raising SIGPIPE
+            static ssize_t WriteSome(detail::ReactorDescriptor& descriptor, std::byte const* data, std::size_t const size)
+            {
+                if (descriptor.isSocket)
+                {
+                    auto const result = ::send(descriptor.fd, data, size, MSG_NOSIGNAL);
+                    if (result >= 0 || errno != ENOTSOCK)
+                    {
+                        return result;
+                    }
+                    descriptor.isSocket = false;
+                }
+
+                return ::write(descriptor.fd, data, size);
+            }
+
+            void Dispatch(std::vector<detail::ReactorCompletion>&& completed)
+            {
+                if (completed.empty())
+                {
+                    return;
+                }
+
+                if (!_executor)
+                {
+                    for (auto& completion : completed)
+                    {
+                        completion();
+                    }
+                    return;
+                }
+
+                // all completions of one batch of events share a single task
+                _executor->Post([batch = std::make_shared<std::vector<detail::ReactorCompletion>>(std::move(completed))]() {
+                    for (auto& completion : *batch)
+                    {
+                        completion();
+                    }
+                });
+            }
+
+            void ThreadLoop()
+            {
+                std::vector<epoll_event> events(std::max<std::size_t>(_options.maxEventsPerWait, 1u));
+                std::vector<detail::ReactorCompletion> completed;
+                bool stopping = false;
+
+                while (!stopping)
+                {
+                    auto const count = ::epoll_wait(_epoll, events.data(), static_cast<int>(events.size()), -1);
+                    if (count < 0)
+                    {
+                        continue;
+                    }
+
+                    for (int i = 0; i < count; ++i)
+                    {
+                        if (events[i].data.fd == _wakeup)
+                        {
+                            stopping = true;
+                            continue;
+                        }
+
+                        auto descriptor = Find(events[i].data.fd);
+                        if (!descriptor)
+                        {
+                            continue;
+                        }
+
+                        auto const flags = events[i].events;
+                        std::unique_lock<std::mutex> lock(descriptor->mutex);
+                        if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+                        {
+                            descriptor->readable = true;
+                            Process(*descriptor, true, completed);
+                        }
+                        if (flags & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+                        {
+                            descriptor->writable = true;
+                            Process(*descriptor, false, completed);
+                        }
+                    }
+
+                    Dispatch(std::move(completed));
+                    completed.clear();
+                }
+            }
+        };
+    }
+}
+
+#endif
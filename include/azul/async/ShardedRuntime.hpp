@@ -0,0 +1,413 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <azul/async/Task.hpp>
+#include <azul/async/detail/CpuRelax.hpp>
+#include <azul/async/detail/MpscQueue.hpp>
+#include <azul/async/detail/SpscQueue.hpp>
+#include <azul/async/detail/ThreadAffinity.hpp>
+#include <azul/async/detail/TimerWheel.hpp>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        struct ShardedRuntimeOptions
+        {
+            // number of shards (threads), zero selects one per hardware thread
+            std::size_t shards = 0;
+            // pins shard i to core i (modulo the number of hardware threads), only supported on linux
+            bool pinThreads = true;
+            // capacity of each cross-shard queue, messages exceeding it wait in a local overflow list of the sender
+            std::size_t queueCapacity = 256;
+            // number of idle polling rounds after which a shard yields its time slice once
+            std::size_t idleSpinsBeforeYield = 1024;
+            std::chrono::milliseconds timerResolution = std::chrono::milliseconds(1);
+        };
+
+        class ShardedRuntime;
+
+        namespace detail
+        {
+            using ShardMessage = std::function<void()>;
+
+            struct CurrentShardInfo
+            {
+                ShardedRuntime const* runtime = nullptr;
+                std::size_t index = 0;
+                std::pmr::memory_resource* resource = nullptr;
+            };
+
+            inline CurrentShardInfo& CurrentShard() noexcept
+            {
+                static thread_local CurrentShardInfo current;
+                return current;
+            }
+
+            // state of one shard, everything apart from the incoming queues is only touched by the thread of the shard
+            class Shard final
+            {
+            public:
+                using Clock = std::chrono::steady_clock;
+
+                explicit Shard(std::size_t const index, std::size_t const numberOfShards, ShardedRuntimeOptions const& options)
+                    : _index(index)
+                    , _idleSpinsBeforeYield(options.idleSpinsBeforeYield)
+                    , _resolution(std::max(std::chrono::duration_cast<Clock::duration>(options.timerResolution), Clock::duration(1)))
+                    , _start(Clock::now())
+                    , _overflow(numberOfShards)
+                {
+                    for (std::size_t i = 0; i < numberOfShards; ++i)
+                    {
+                        _incoming.emplace_back(std::make_unique<SpscQueue<ShardMessage>>(options.queueCapacity));
+                    }
+                }
+
+                // messages from threads which are not shards of the runtime
+                void PostExternal(ShardMessage&& message)
+                {
+                    _external.Push(std::move(message));
+                }
+
+                // called on this shard
+                void PostLocal(ShardMessage&& message)
+                {
+                    _local.emplace_back(std::move(message));
+                }
+
+                // called on this shard, the message is appended to the queue of the target shard reserved for this shard
+                void Send(Shard& target, ShardMessage&& message)
+                {
+                    auto& overflow = _overflow[target._index];
+                    if (!overflow.empty() || !target._incoming[_index]->TryPush(std::move(message)))
+                    {
+                        overflow.emplace_back(std::move(message));
+                    }
+                }
+
+                // called on this shard
+                void AddTimer(Clock::time_point const& timePoint, ShardMessage&& message)
+                {
+                    auto const delay = std::max(timePoint - _start, Clock::duration(0));
+                    _timers.Add(static_cast<std::uint64_t>((delay + _resolution - Clock::duration(1)) / _resolution), std::move(message));
+                }
+
+                void Run(ShardedRuntime const& runtime, std::atomic<bool> const& shutdownInitiated, std::vector<std::unique_ptr<Shard>>& shards)
+                {
+                    CurrentShard() = { &runtime, _index, &_arena };
+
+                    std::size_t idleRounds = 0;
+                    while (!shutdownInitiated.load(std::memory_order_acquire))
+                    {
+                        bool worked = FlushOverflow(shards);
+                        worked |= RunIncoming();
+                        worked |= RunTimers();
+                        worked |= RunLocal();
+
+                        if (worked)
+                        {
+                            idleRounds = 0;
+                        }
+                        else if (++idleRounds >= _idleSpinsBeforeYield)
+                        {
+                            idleRounds = 0;
+                            std::this_thread::yield();
+                        }
+                        else
+                        {
+                            CpuRelax();
+                        }
+                    }
+
+                    CurrentShard() = { };
+                }
+
+            private:
+                // number of messages taken from a single queue per polling round, keeps busy senders from starving others
+                static constexpr std::size_t Budget = 64;
+
+                std::size_t const _index;
+                std::size_t const _idleSpinsBeforeYield;
+                Clock::duration const _resolution;
+                Clock::time_point const _start;
+
+                // declared before the queues, messages destroyed with them may still own memory of the arena
+                std::pmr::unsynchronized_pool_resource _arena;
+
+                std::vector<std::unique_ptr<SpscQueue<ShardMessage>>> _incoming;
+                MpscQueue<ShardMessage> _external;
+
+                std::deque<ShardMessage> _local;
+                std::vector<std::deque<ShardMessage>> _overflow;
+                TimerWheel<ShardMessage> _timers;
+                std::vector<ShardMessage> _expired;
+
+                bool FlushOverflow(std::vector<std::unique_ptr<Shard>>& shards)
+                {
+                    bool flushed = false;
+                    for (std::size_t target = 0; target < _overflow.size(); ++target)
+                    {
+                        auto& overflow = _overflow[target];
+                        while (!overflow.empty() && shards[target]->_incoming[_index]->TryPush(std::move(overflow.front())))
+                        {
+                            overflow.pop_front();
+                            flushed = true;
+                        }
+                    }
+                    return flushed;
+                }
+
+                bool RunIncoming()
+                {
+                    bool worked = false;
+                    for (auto& queue : _incoming)
+                    {
+                        for (std::size_t i = 0; i < Budget; ++i)
+                        {
+                            auto message = queue->TryPop();
+                            if (!message)
+                            {
+                                break;
+                            }
+                            (*message)();
+                            worked = true;
+                        }
+                    }
+
+                    for (std::size_t i = 0; i < Budget; ++i)
+                    {
+                        auto message = _external.TryPop();
+                        if (!message)
+                        {
+                            break;
+                        }
+                        (*message)();
+                        worked = true;
+                    }
+                    return worked;
+                }
+
+                bool RunTimers()
+                {
+                    if (_timers.Empty())
+                    {
+                        return false;
+                    }
+
+                    _timers.Advance(static_cast<std::uint64_t>((Clock::now() - _start) / _resolution), _expired);
+                    if (_expired.empty())
+                    {
+                        return false;
+                    }
+
+                    for (auto& message : _expired)
+                    {
+                        message();
+                    }
+                    _expired.clear();
+                    return true;
+                }
+
+                // only runs the messages queued before this round, messages they post run in the next round
+                bool RunLocal()
+                {
+                    auto const worked = !_local.empty();
+                    for (auto pending = _local.size(); pending > 0; --pending)
+                    {
+                        auto message = std::move(_local.front());
+                        _local.pop_front();
+                        message();
+                    }
+                    return worked;
+                }
+            };
+        }
+
+        // shared-nothing runtime with one (pinned) thread per shard: every shard owns its task queue, timer wheel
+        // and memory arena, work moves between shards only as messages through lock-free single-producer queues
+        // the future returned by SubmitTo is completed on the submitting shard, continuations attached there
+        // therefore run on the submitting shard as well and can access its state without locks
+        class ShardedRuntime final
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            explicit ShardedRuntime(ShardedRuntimeOptions const& options = { })
+            {
+                auto const hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+                auto const numberOfShards = options.shards == 0 ? hardwareThreads : options.shards;
+
+                for (std::size_t i = 0; i < numberOfShards; ++i)
+                {
+                    _shards.emplace_back(std::make_unique<detail::Shard>(i, numberOfShards, options));
+                }
+
+                for (std::size_t i = 0; i < numberOfShards; ++i)
+                {
+                    _threads.emplace_back([this, i]() {
+                        _shards[i]->Run(*this, _shutdownInitiated, _shards);
+                    });
+
+                    if (options.pinThreads)
+                    {
+                        detail::PinThread(_threads.back(), static_cast<int>(i % hardwareThreads));
+                    }
+                }
+            }
+
+            // messages which were not processed yet are destroyed, their futures report a broken promise
+            ~ShardedRuntime()
+            {
+                _shutdownInitiated.store(true, std::memory_order_release);
+                std::for_each(_threads.begin(), _threads.end(), [](auto& t) { t.join(); });
+            }
+
+            ShardedRuntime(ShardedRuntime const&) = delete;
+            ShardedRuntime(ShardedRuntime&&) = delete;
+            ShardedRuntime& operator=(ShardedRuntime const&) = delete;
+            ShardedRuntime& operator=(ShardedRuntime&&) = delete;
+
+            std::size_t ShardCount() const noexcept
+            {
+                return _shards.size();
+            }
+
+            // executes the callable on the given shard
+            template<typename T, typename TResult=std::invoke_result_t<T>>
+            Future<TResult> SubmitTo(std::size_t const shard, T&& callable)
+            {
+                CheckShard(shard);
+
+                auto future = Future<TResult>();
+                auto message = MakeMessage<TResult>(std::function<TResult()>(std::forward<T>(callable)), future);
+                Post(shard, std::move(message));
+                return future;
+            }
+
+            // executes the callable on the given shard once the delay elapsed, the timer is kept by the wheel of that shard
+            template<typename T, class Rep, class Period, typename TResult=std::invoke_result_t<T>>
+            Future<TResult> SubmitAfter(std::size_t const shard, std::chrono::duration<Rep, Period> const& delay, T&& callable)
+            {
+                CheckShard(shard);
+
+                auto future = Future<TResult>();
+                auto message = MakeMessage<TResult>(std::function<TResult()>(std::forward<T>(callable)), future);
+                auto const timePoint = Clock::now() + std::chrono::duration_cast<Clock::duration>(delay);
+
+                Post(shard, [this, shard, timePoint, message = std::move(message)]() mutable {
+                    _shards[shard]->AddTimer(timePoint, std::move(message));
+                });
+                return future;
+            }
+
+            // true if the caller runs on a shard of any runtime
+            static bool RunningOnShard() noexcept
+            {
+                return detail::CurrentShard().runtime != nullptr;
+            }
+
+            static std::size_t CurrentShard()
+            {
+                CheckRunningOnShard();
+                return detail::CurrentShard().index;
+            }
+
+            // arena of the calling shard for shard local state, it is not synchronized:
+            // memory allocated from it must neither be released nor used by any other thread
+            static std::pmr::memory_resource* LocalMemoryResource()
+            {
+                CheckRunningOnShard();
+                return detail::CurrentShard().resource;
+            }
+
+        private:
+            std::vector<std::unique_ptr<detail::Shard>> _shards;
+            std::vector<std::thread> _threads;
+            std::atomic<bool> _shutdownInitiated{ false };
+
+            static constexpr std::size_t NoShard = std::numeric_limits<std::size_t>::max();
+
+            static void CheckRunningOnShard()
+            {
+                if (!RunningOnShard())
+                {
+                    throw std::logic_error("The calling thread is not a shard of a sharded runtime.");
+                }
+            }
+
+            void CheckShard(std::size_t const shard) const
+            {
+                if (shard >= _shards.size())
+                {
+                    throw std::out_of_range("The shard does not exist.");
+                }
+            }
+
+            std::size_t CurrentShardOfThisRuntime() const noexcept
+            {
+                auto const& current = detail::CurrentShard();
+                return current.runtime == this ? current.index : NoShard;
+            }
+
+            void Post(std::size_t const shard, detail::ShardMessage&& message)
+            {
+                auto const origin = CurrentShardOfThisRuntime();
+                if (origin == NoShard)
+                {
+                    _shards[shard]->PostExternal(std::move(message));
+                }
+                else if (origin == shard)
+                {
+                    _shards[shard]->PostLocal(std::move(message));
+                }
+                else
+                {
+                    _shards[origin]->Send(*_shards[shard], std::move(message));
+                }
+            }
+
+            // executes the callable on the target shard and sends the result back to the submitting shard
+            template <typename TResult>
+            detail::ShardMessage MakeMessage(std::function<TResult()>&& callable, Future<TResult>& future)
+            {
+                auto futureState = std::make_shared<detail::FutureState<TResult>>();
+                auto futureStateAsPromise = std::shared_ptr<detail::FutureState<TResult>>(futureState.get(), [futureState](auto*){
+                    futureState->AboutToDestroyPromise();
+                });
+                future = Future<TResult>(futureState);
+
+                auto const origin = CurrentShardOfThisRuntime();
+                auto sharedCallable = std::make_shared<std::function<TResult()>>(std::move(callable));
+
+                return [this, origin, sharedCallable, promise = std::move(futureStateAsPromise)]() {
+                    Task<TResult> task(std::move(*sharedCallable));
+                    auto result = task.GetFuture();
+                    task();
+
+                    auto const current = CurrentShardOfThisRuntime();
+                    if (origin == NoShard || origin == current)
+                    {
+                        detail::ForwardResult(result, *promise);
+                        return;
+                    }
+
+                    _shards[current]->Send(*_shards[origin], [result, promise]() mutable {
+                        detail::ForwardResult(result, *promise);
+                    });
+                };
+            }
+        };
+    }
+}
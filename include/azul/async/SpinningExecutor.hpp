@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <azul/async/Task.hpp>
+#include <azul/async/detail/CpuRelax.hpp>
+#include <azul/async/detail/MpscQueue.hpp>
+#include <azul/async/detail/ThreadAffinity.hpp>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        struct SpinningExecutorOptions
+        {
+            // cores the threads are pinned to (thread i runs on cpus[i % cpus.size()]), empty disables pinning
+            // pinning is only supported on linux and silently ignored elsewhere
+            std::vector<int> cpus;
+        };
+
+        // executor for latency critical work: every thread busy polls its own lock-free queue and never parks,
+        // a task is therefore picked up within the time of a cache line transfer instead of a thread wakeup
+        // the threads occupy their cores completely, the executor should only be used with dedicated cores
+        class SpinningExecutor final
+        {
+        public:
+            explicit SpinningExecutor(std::size_t const numberOfThreads, SpinningExecutorOptions const& options = { })
+                : _queues(std::max<std::size_t>(numberOfThreads, 1u))
+            {
+                for (std::size_t i = 0; i < _queues.size(); ++i)
+                {
+                    _queues[i] = std::make_unique<detail::MpscQueue<std::shared_ptr<TaskBase>>>();
+                }
+
+                for (std::size_t i = 0; i < _queues.size(); ++i)
+                {
+                    _threads.emplace_back([this, i]() {
+                        ThreadLoop(*_queues[i]);
+                    });
+
+                    if (!options.cpus.empty())
+                    {
+                        detail::PinThread(_threads.back(), options.cpus[i % options.cpus.size()]);
+                    }
+                }
+            }
+
+            // tasks which did not start yet are destroyed, their futures report a broken promise
+            ~SpinningExecutor()
+            {
+                _shutdownInitiated.store(true, std::memory_order_release);
+                std::for_each(_threads.begin(), _threads.end(), [](auto& t) { t.join(); });
+            }
+
+            SpinningExecutor(SpinningExecutor const&) = delete;
+            SpinningExecutor(SpinningExecutor&&) = delete;
+            SpinningExecutor& operator=(SpinningExecutor const&) = delete;
+            SpinningExecutor& operator=(SpinningExecutor&&) = delete;
+
+            std::size_t ThreadCount() const noexcept
+            {
+                return _threads.size();
+            }
+
+            template<typename T, typename TResult=std::invoke_result_t<T>, typename... TFutures>
+            Future<TResult> Execute(T&& callable, TFutures&&... dependencies)
+            {
+                const auto newTask = std::make_shared<Task<TResult>>(std::function<TResult()>(std::forward<T>(callable)), azul::async::WhenAll(dependencies...));
+                auto future = newTask->GetFuture();
+
+                auto const index = _nextQueue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+                _queues[index]->Push(newTask);
+
+                return future;
+            }
+
+        private:
+            std::vector<std::unique_ptr<detail::MpscQueue<std::shared_ptr<TaskBase>>>> _queues;
+            std::vector<std::thread> _threads;
+            std::atomic<std::size_t> _nextQueue{ 0 };
+            std::atomic<bool> _shutdownInitiated{ false };
+
+            // deferred tasks are also rechecked after this many tasks taken from a queue which never runs empty
+            static constexpr std::uint32_t DeferredCheckInterval = 64;
+
+            void ThreadLoop(detail::MpscQueue<std::shared_ptr<TaskBase>>& queue)
+            {
+                // tasks with pending dependencies are parked on the worker instead of being pushed through the queue again
+                std::vector<std::shared_ptr<TaskBase>> deferred;
+                std::uint32_t sinceCheck = 0;
+
+                while (!_shutdownInitiated.load(std::memory_order_acquire))
+                {
+                    auto task = queue.TryPop();
+                    if (!task || ++sinceCheck == DeferredCheckInterval)
+                    {
+                        sinceCheck = 0;
+                        if (!RunReady(deferred) && !task)
+                        {
+                            detail::CpuRelax();
+                        }
+                    }
+
+                    if (!task)
+                    {
+                        continue;
+                    }
+
+                    if (!(*task)->IsReady())
+                    {
+                        deferred.push_back(std::move(*task));
+                        continue;
+                    }
+
+                    (*task)->operator()();
+                }
+            }
+
+            // runs the deferred tasks whose dependencies completed, false if none did
+            static bool RunReady(std::vector<std::shared_ptr<TaskBase>>& deferred)
+            {
+                auto ran = false;
+                for (std::size_t i = 0; i < deferred.size();)
+                {
+                    if (!deferred[i]->IsReady())
+                    {
+                        ++i;
+                        continue;
+                    }
+
+                    auto task = std::move(deferred[i]);
+                    deferred[i] = std::move(deferred.back());
+                    deferred.pop_back();
+
+                    task->operator()();
+                    ran = true;
+                }
+                return ran;
+            }
+        };
+    }
+}
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <condition_variable>
 #include <cstdint>
 #include <azul/async/Future.hpp>
 #include <azul/async/Task.hpp>
+#include <azul/async/ThreadPoolMetrics.hpp>
 #include <azul/utils/Disposer.hpp>
 #include <list>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -15,17 +18,58 @@ namespace azul
 {
     namespace async
     {
+        // defines what happens to a task submitted while the queue of a bounded thread pool is full
+        enum class OverflowPolicy : std::uint32_t
+        {
+            // block the submitting thread until space becomes available, a worker of the thread pool itself
+            // cannot wait for space (no worker might make any) and handles its tasks as with CallerRuns instead
+            Block = 0,
+            // do not enqueue the task and return a future holding a FutureError(QueueFull)
+            Reject = 1,
+            // execute the task on the submitting thread, a task still waiting for its dependencies is enqueued
+            // beyond the capacity instead (waiting for them on a worker could deadlock the thread pool)
+            CallerRuns = 2,
+            // discard the oldest queued task (its future reports a broken promise) and enqueue the new one
+            DropOldest = 3
+        };
+
+        struct StaticThreadPoolOptions
+        {
+            // maximum number of queued tasks, zero means unbounded
+            std::size_t capacity = 0;
+            OverflowPolicy overflowPolicy = OverflowPolicy::Block;
+            // resource used for tasks and their futures, nullptr selects the default resource
+            // tasks are allocated on the submitting threads, the resource therefore has to be thread safe
+            // (e.g. std::pmr::synchronized_pool_resource) if tasks are submitted concurrently
+            std::pmr::memory_resource* memoryResource = nullptr;
+        };
+
+        struct QueueStatistics
+        {
+            std::size_t depth = 0;
+            std::size_t peakDepth = 0;
+            std::size_t capacity = 0;
+            std::uint64_t blockedSubmissions = 0;
+            std::uint64_t rejectedTasks = 0;
+            std::uint64_t callerRunsTasks = 0;
+            std::uint64_t droppedTasks = 0;
+        };
+
         class StaticThreadPool
         {
         public:
-            explicit StaticThreadPool(const std::size_t numberOfThreads)
+            explicit StaticThreadPool(const std::size_t numberOfThreads, StaticThreadPoolOptions const& options = { })
+                : _options(options)
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+                , _metrics(numberOfThreads)
+#endif
             {
                 std::unique_lock<std::mutex> lock(_mutex);
 
                 for (std::uint32_t i = 0; i < numberOfThreads; ++i)
                 {
-                    _threads.emplace_back([this](){
-                        ThreadLoop();
+                    _threads.emplace_back([this, i](){
+                        ThreadLoop(i);
                     });
                 }
             }
@@ -46,26 +90,161 @@ namespace azul
             template<typename T, typename TResult=std::invoke_result_t<T>, typename... TFutures>
             Future<TResult> Execute(T&& callable, TFutures&&... dependencies)
             {
-                std::unique_lock<std::mutex> lock(_mutex);
+                return Execute(std::allocator_arg, _options.memoryResource ? _options.memoryResource : std::pmr::get_default_resource(), std::forward<T>(callable), std::forward<TFutures>(dependencies)...);
+            }
 
-                const auto newTask = std::make_shared<Task<TResult>>(std::function<TResult()>(callable), azul::async::WhenAll(dependencies...));
-                _tasks.emplace_back(newTask);
+            // the task and its future are allocated from the given resource (e.g. a request scoped arena),
+            // the resource has to outlive the task and all futures derived from it
+            template<typename T, typename TResult=std::invoke_result_t<T>, typename... TFutures>
+            Future<TResult> Execute(std::allocator_arg_t, std::pmr::memory_resource* resource, T&& callable, TFutures&&... dependencies)
+            {
+                const auto newTask = std::allocate_shared<Task<TResult>>(std::pmr::polymorphic_allocator<Task<TResult>>(resource),
+                    std::function<TResult()>(callable), azul::async::WhenAll(std::allocator_arg, resource, dependencies...), resource);
+                return Submit(newTask, true);
+            }
 
-                _condition.notify_one();
+            // hands the callable over without ever blocking the caller or running the callable on its thread (e.g. from
+            // a timer thread), Block and CallerRuns enqueue it beyond the capacity instead, Reject and DropOldest apply
+            template<typename T, typename TResult=std::invoke_result_t<T>>
+            Future<TResult> Dispatch(T&& callable)
+            {
+                auto* const resource = _options.memoryResource ? _options.memoryResource : std::pmr::get_default_resource();
+                const auto newTask = std::allocate_shared<Task<TResult>>(std::pmr::polymorphic_allocator<Task<TResult>>(resource),
+                    std::function<TResult()>(std::forward<T>(callable)), Future<void>(), resource);
+                return Submit(newTask, false);
+            }
 
-                return newTask->GetFuture();
+            std::size_t QueueDepth() const
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                return _tasks.size();
             }
 
+            QueueStatistics Statistics() const
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+
+                auto statistics = _statistics;
+                statistics.depth = _tasks.size();
+                statistics.capacity = _options.capacity;
+                return statistics;
+            }
+
+            // the queue depth and, if compiled with LIBAZUL_WITH_ASYNC_METRICS, task timings and worker utilization
+            ThreadPoolMetricsSnapshot Metrics() const
+            {
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+                auto snapshot = _metrics.Snapshot();
+#else
+                ThreadPoolMetricsSnapshot snapshot;
+#endif
+                snapshot.queueDepth = QueueDepth();
+                return snapshot;
+            }
 
         private:            
             std::condition_variable _condition;
+            std::condition_variable _spaceAvailable;
             mutable std::mutex _mutex;
 
+            StaticThreadPoolOptions const _options;
+            QueueStatistics _statistics;
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+            detail::ThreadPoolMetrics _metrics;
+#endif
+
             std::list<std::shared_ptr<azul::async::TaskBase>> _tasks;
             std::vector<std::thread> _threads;
 
             bool _shutdownInitiated = false;
 
+            static StaticThreadPool*& CurrentPool() noexcept
+            {
+                static thread_local StaticThreadPool* current = nullptr;
+                return current;
+            }
+
+            // applies the overflow policy, the caller is only blocked or runs the task itself if it allows to
+            template<typename TResult>
+            Future<TResult> Submit(std::shared_ptr<Task<TResult>> const& newTask, bool const callerMayRun)
+            {
+                auto future = newTask->GetFuture();
+
+                std::shared_ptr<azul::async::TaskBase> droppedTask;
+                std::unique_lock<std::mutex> lock(_mutex);
+
+                if (QueueFull())
+                {
+                    switch (_options.overflowPolicy)
+                    {
+                    case OverflowPolicy::Block:
+                        if (!callerMayRun)
+                        {
+                            break;
+                        }
+
+                        if (CurrentPool() == this)
+                        {
+                            if (newTask->IsReady())
+                            {
+                                return RunOnCaller(newTask, future, lock);
+                            }
+                            break;
+                        }
+
+                        ++_statistics.blockedSubmissions;
+                        _spaceAvailable.wait(lock, [this]() { return !QueueFull() || _shutdownInitiated; });
+                        break;
+                    case OverflowPolicy::Reject:
+                    {
+                        ++_statistics.rejectedTasks;
+                        return MakeExceptionalFuture<TResult>(FutureError(FutureErrorCode::QueueFull));
+                    }
+                    case OverflowPolicy::CallerRuns:
+                        if (callerMayRun && newTask->IsReady())
+                        {
+                            return RunOnCaller(newTask, future, lock);
+                        }
+                        break;
+                    case OverflowPolicy::DropOldest:
+                        ++_statistics.droppedTasks;
+                        // destroyed after releasing the lock, destroying the promise may run arbitrary destructors
+                        droppedTask = std::move(_tasks.front());
+                        _tasks.pop_front();
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+                        Unblock(*droppedTask, detail::MetricsNow());
+#endif
+                        break;
+                    }
+                }
+
+                _tasks.emplace_back(newTask);
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+                Enqueued(newTask);
+                _metrics.Submitted(_tasks.size());
+#endif
+                _statistics.peakDepth = std::max(_statistics.peakDepth, _tasks.size());
+
+                _condition.notify_one();
+
+                return future;
+            }
+
+            template<typename TResult>
+            Future<TResult> RunOnCaller(std::shared_ptr<Task<TResult>> const& task, Future<TResult> const& future, std::unique_lock<std::mutex>& lock)
+            {
+                ++_statistics.callerRunsTasks;
+                lock.unlock();
+
+                task->operator()();
+                return future;
+            }
+
+            bool QueueFull() const
+            {
+                return _options.capacity != 0 && _tasks.size() >= _options.capacity;
+            }
+
             std::shared_ptr<azul::async::TaskBase> NextTask()
             {
                 auto it = _tasks.begin();
@@ -82,14 +261,24 @@ namespace azul
                 {
                     auto task = *it;
                     _tasks.erase(it);
+
+                    if (_options.capacity != 0)
+                    {
+                        _spaceAvailable.notify_one();
+                    }
                     return task;
                 }
 
                 return {};
             }
 
-            void ThreadLoop()
+            void ThreadLoop([[maybe_unused]] std::size_t const worker)
             {
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+                auto idleSince = detail::MetricsNow();
+                auto parked = false;
+#endif
+                CurrentPool() = this;
                 std::unique_lock<std::mutex> lock(_mutex);
 
                 while (!_shutdownInitiated)
@@ -98,7 +287,30 @@ namespace azul
                     if (task)
                     {
                         lock.unlock();
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+                        auto& timestamps = task->Timestamps();
+                        timestamps.started = detail::MetricsNow();
+                        _metrics.Idle(worker, timestamps.started - idleSince);
+                        // the continuation of the dependency might not have run yet
+                        Unblock(*task, timestamps.started);
+
                         task->operator()();
+                        if (!CurrentPool())
+                        {
+                            return;
+                        }
+
+                        timestamps.finished = detail::MetricsNow();
+                        _metrics.Executed(worker, timestamps.runnable.load(std::memory_order_acquire), timestamps.started, timestamps.finished);
+                        idleSince = timestamps.finished;
+                        parked = false;
+#else
+                        task->operator()();
+                        if (!CurrentPool())
+                        {
+                            return;
+                        }
+#endif
                         lock.lock();
 
                         // number of continuations equals the amount of tasks waiting
@@ -111,21 +323,84 @@ namespace azul
 
                     if (!task && !_shutdownInitiated)
                     {
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+                        // timeouts and spurious wakeups without a task in between belong to the same idle period
+                        if (!parked)
+                        {
+                            _metrics.Parked(worker);
+                            parked = true;
+                        }
+                        _condition.wait_for(lock, std::chrono::milliseconds(1000));
+
+                        // idle periods are accounted when parking ends, so an idle worker shows up in snapshots
+                        auto const now = detail::MetricsNow();
+                        _metrics.Idle(worker, now - idleSince);
+                        idleSince = now;
+#else
                         _condition.wait_for(lock, std::chrono::milliseconds(1000));
+#endif
                     }
                 }
             }
 
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+            // stamps the submission, a task waiting for dependencies becomes runnable once the last one completed
+            void Enqueued(std::shared_ptr<azul::async::TaskBase> const& task)
+            {
+                auto& timestamps = task->Timestamps();
+                timestamps.enqueued = detail::MetricsNow();
+
+                if (task->IsReady())
+                {
+                    timestamps.runnable.store(timestamps.enqueued, std::memory_order_release);
+                    return;
+                }
+
+                _metrics.BlockedTasks()->fetch_add(1, std::memory_order_relaxed);
+
+                // the task is only referenced weakly, it might be dropped or destroyed with the pool before
+                task->Dependency().Then([blockedTasks = _metrics.BlockedTasks(), weakTask = std::weak_ptr<azul::async::TaskBase>(task)](azul::async::Future<void>) {
+                    if (auto const blockedTask = weakTask.lock())
+                    {
+                        if (blockedTask->Timestamps().MarkRunnable(detail::MetricsNow()))
+                        {
+                            blockedTasks->fetch_sub(1, std::memory_order_relaxed);
+                        }
+                    }
+                });
+            }
+
+            void Unblock(azul::async::TaskBase& task, std::uint64_t const now)
+            {
+                if (task.Timestamps().MarkRunnable(now))
+                {
+                    _metrics.BlockedTasks()->fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+#endif
+
             void ShutdownNotifyThreads()
             {
                 std::unique_lock<std::mutex> lock(_mutex);
                 _shutdownInitiated = true;
                 _condition.notify_all();
+                _spaceAvailable.notify_all();
             }
 
+            // a task releasing the last reference destroys the pool on its worker, which cannot join itself:
+            // the worker is detached instead and leaves its loop without touching the pool once the task returned
             void ShutdownJoinThreads()
             {
-                std::for_each(_threads.begin(), _threads.end(), [](auto& t) { t.join(); });
+                for (auto& thread : _threads)
+                {
+                    if (thread.get_id() == std::this_thread::get_id())
+                    {
+                        CurrentPool() = nullptr;
+                        thread.detach();
+                        continue;
+                    }
+                    thread.join();
+                }
             }
 
             void ShutdownDestroyRemainingTasks()
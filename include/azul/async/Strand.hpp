@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <azul/async/Future.hpp>
+#include <azul/async/Task.hpp>
+#include <azul/async/detail/MpscQueue.hpp>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            template <typename TExecutor>
+            class StrandState final : public std::enable_shared_from_this<StrandState<TExecutor>>
+            {
+            public:
+                explicit StrandState(TExecutor& executor, std::size_t const maxBatchSize)
+                    : _executor(executor)
+                    , _maxBatchSize(std::max<std::size_t>(maxBatchSize, 1u))
+                {
+
+                }
+
+                void Enqueue(std::shared_ptr<azul::async::TaskBase>&& task)
+                {
+                    _tasks.Push(std::move(task));
+
+                    // only the producer which observes the transition from idle to busy
+                    // schedules the strand, everybody else just hands over its task
+                    if (_pending.fetch_add(1, std::memory_order_acq_rel) == 0)
+                    {
+                        Schedule();
+                    }
+                }
+
+                bool RunningInThisThread() const noexcept
+                {
+                    return CurrentStrand() == this;
+                }
+
+            private:
+                TExecutor& _executor;
+                std::size_t const _maxBatchSize;
+
+                detail::MpscQueue<std::shared_ptr<azul::async::TaskBase>> _tasks;
+                std::atomic<std::size_t> _pending{ 0 };
+
+                static void const*& CurrentStrand() noexcept
+                {
+                    static thread_local void const* current = nullptr;
+                    return current;
+                }
+
+                // a drain task rejected or dropped by a bounded thread pool would leave the strand busy forever,
+                // the announced tasks are failed with the error of the executor instead and the strand becomes idle
+                void Schedule()
+                {
+                    auto drain = [self = this->shared_from_this()]() {
+                        self->Drain();
+                    };
+
+                    detail::OnFailure(_executor.Execute(std::move(drain)), [weakSelf = this->weak_from_this()](std::exception_ptr const& exception) {
+                        if (auto const self = weakSelf.lock())
+                        {
+                            self->Reject(exception);
+                        }
+                    });
+                }
+
+                void Reject(std::exception_ptr const& exception) noexcept
+                {
+                    for (;;)
+                    {
+                        auto task = _tasks.TryPop();
+                        if (!task)
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+
+                        (*task)->Fail(exception);
+                        task.reset();
+
+                        if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                void Drain()
+                {
+                    auto const previousStrand = CurrentStrand();
+                    CurrentStrand() = this;
+
+                    std::size_t processed = 0;
+
+                    for (;;)
+                    {
+                        auto task = _tasks.TryPop();
+                        if (!task)
+                        {
+                            // a producer already announced its task but did not link it into the queue yet
+                            std::this_thread::yield();
+                            continue;
+                        }
+
+                        (*task)->operator()();
+                        task.reset();
+                        ++processed;
+
+                        if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        {
+                            break;
+                        }
+
+                        // give other work scheduled on the executor a chance to run
+                        if (processed >= _maxBatchSize)
+                        {
+                            Schedule();
+                            break;
+                        }
+                    }
+
+                    CurrentStrand() = previousStrand;
+                }
+            };
+        }
+
+        // executes callables one at a time and in submission order on top of another executor
+        // the strand never blocks a thread of the underlying executor while waiting for its turn
+        template <typename TExecutor>
+        class Strand final
+        {
+        public:
+            explicit Strand(std::shared_ptr<TExecutor> const& executor, std::size_t const maxBatchSize = 64)
+                : _executor(executor)
+                , _state(std::make_shared<detail::StrandState<TExecutor>>(*executor, maxBatchSize))
+            {
+
+            }
+
+            Strand(Strand const&) = default;
+            Strand(Strand&&) = default;
+            Strand& operator=(Strand const&) = default;
+            Strand& operator=(Strand&&) = default;
+
+            template<typename T, typename TResult=std::invoke_result_t<T>>
+            Future<TResult> Execute(T&& callable)
+            {
+                auto newTask = std::make_shared<Task<TResult>>(std::function<TResult()>(std::forward<T>(callable)));
+                auto future = newTask->GetFuture();
+
+                _state->Enqueue(std::move(newTask));
+
+                return future;
+            }
+
+            bool RunningInThisThread() const noexcept
+            {
+                return _state->RunningInThisThread();
+            }
+
+        private:
+            // the executor is owned by the strand handles and not by the shared state because the state is
+            // kept alive by tasks running on the executor (which would otherwise destroy it from its own thread)
+            std::shared_ptr<TExecutor> _executor;
+            std::shared_ptr<detail::StrandState<TExecutor>> _state;
+        };
+    }
+}
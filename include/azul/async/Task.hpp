@@ -1,14 +1,37 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <functional>
 #include <azul/async/Future.hpp>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 
 namespace azul
 {
     namespace async
     {
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+        // steady clock nanoseconds, set by the thread pool executing the task
+        struct TaskTimestamps
+        {
+            std::uint64_t enqueued = 0;
+            // set once by whoever first sees the dependencies completed, the continuation of the dependency or the worker
+            std::atomic<std::uint64_t> runnable{ 0 };
+            std::uint64_t started = 0;
+            std::uint64_t finished = 0;
+
+            // true if this call set the timestamp
+            bool MarkRunnable(std::uint64_t const now) noexcept
+            {
+                std::uint64_t expected = 0;
+                return runnable.compare_exchange_strong(expected, now, std::memory_order_acq_rel);
+            }
+        };
+#endif
+
         class TaskBase
         {
         public:
@@ -26,6 +49,8 @@ namespace azul
 
             virtual ~TaskBase() = default;
             virtual void operator()() noexcept = 0;
+            // completes the task with the exception instead of running it
+            virtual void Fail(std::exception_ptr const& exception) noexcept = 0;
 
             virtual bool IsReady() const noexcept
             {
@@ -33,18 +58,34 @@ namespace azul
             }
 
             virtual std::size_t NumberOfContinuations() const = 0;
+
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+            TaskTimestamps& Timestamps() noexcept
+            {
+                return _timestamps;
+            }
+
+            azul::async::Future<void> Dependency() const noexcept
+            {
+                return _dependency;
+            }
+#endif
         
         private:
             azul::async::Future<void> _dependency;
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+            TaskTimestamps _timestamps;
+#endif
         };
 
         template <typename TResult>
         class Task : public TaskBase
         {
         public:
-            explicit Task(std::function<TResult()> && func, azul::async::Future<void> const& dependency = { })
+            explicit Task(std::function<TResult()> && func, azul::async::Future<void> const& dependency = { }, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
                 : TaskBase(dependency)
-                , _func(std::make_shared<std::function<TResult()>>(func))
+                , _promise(resource)
+                , _func(std::allocate_shared<std::function<TResult()>>(std::pmr::polymorphic_allocator<std::function<TResult()>>(resource), std::move(func)))
             {
                 
             }
@@ -63,6 +104,17 @@ namespace azul
                 }
             }
 
+            void Fail(std::exception_ptr const& exception) noexcept override
+            {
+                try
+                {
+                    _promise.SetException(exception);
+                }
+                catch(...)
+                {
+                }
+            }
+
             azul::async::Future<TResult> GetFuture() { return _promise.GetFuture(); }
 
             std::size_t NumberOfContinuations() const override
@@ -79,9 +131,10 @@ namespace azul
         class Task<void> : public TaskBase
         {
         public:
-            explicit Task(std::function<void()> && func, azul::async::Future<void> const& dependency = { })
+            explicit Task(std::function<void()> && func, azul::async::Future<void> const& dependency = { }, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
                 : TaskBase(dependency)
-                , _func(std::make_shared<std::function<void()>>(func))
+                , _promise(resource)
+                , _func(std::allocate_shared<std::function<void()>>(std::pmr::polymorphic_allocator<std::function<void()>>(resource), std::move(func)))
             {
 
             }
@@ -100,6 +153,17 @@ namespace azul
                 }
             }
 
+            void Fail(std::exception_ptr const& exception) noexcept override
+            {
+                try
+                {
+                    _promise.SetException(exception);
+                }
+                catch(...)
+                {
+                }
+            }
+
             azul::async::Future<void> GetFuture() { return _promise.GetFuture(); }
             
             std::size_t NumberOfContinuations() const override
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <azul/async/Histogram.hpp>
+#include <memory>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        struct WorkerMetricsSnapshot
+        {
+            std::uint64_t executedTasks = 0;
+            // time spent running tasks and waiting for tasks (nanoseconds)
+            std::uint64_t busyTime = 0;
+            std::uint64_t idleTime = 0;
+            // number of idle periods, i.e. times the worker went to sleep after running a task because no task was ready
+            std::uint64_t parks = 0;
+
+            double Utilization() const noexcept
+            {
+                auto const total = busyTime + idleTime;
+                return total == 0 ? 0.0 : static_cast<double>(busyTime) / static_cast<double>(total);
+            }
+        };
+
+        // the histograms and worker metrics are only recorded if the library is compiled with LIBAZUL_WITH_ASYNC_METRICS
+        // (which has to be defined consistently for every translation unit), otherwise enabled is false
+        struct ThreadPoolMetricsSnapshot
+        {
+            bool enabled = false;
+            std::size_t queueDepth = 0;
+            std::uint64_t submittedTasks = 0;
+            std::uint64_t executedTasks = 0;
+            // time from the submission until a worker picked the task up (nanoseconds),
+            // for tasks with dependencies the time starts once the last dependency completed
+            HistogramSnapshot waitTime;
+            // time the worker spent in the task including continuations running inline (nanoseconds)
+            HistogramSnapshot runTime;
+            // number of queued runnable tasks seen by each submission (including the submitted one if it is runnable),
+            // tasks still waiting for their dependencies are not counted
+            HistogramSnapshot queueDepthOnSubmit;
+            std::vector<WorkerMetricsSnapshot> workers;
+        };
+
+        namespace detail
+        {
+            inline std::uint64_t MetricsNow() noexcept
+            {
+                return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+            }
+
+            // written by the owning worker only, read by snapshots
+            struct alignas(64) WorkerMetrics
+            {
+                std::atomic<std::uint64_t> executedTasks{ 0 };
+                std::atomic<std::uint64_t> busyTime{ 0 };
+                std::atomic<std::uint64_t> idleTime{ 0 };
+                std::atomic<std::uint64_t> parks{ 0 };
+
+                void Add(std::atomic<std::uint64_t>& counter, std::uint64_t const value) noexcept
+                {
+                    // single writer, no read-modify-write needed
+                    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+                }
+            };
+
+            class ThreadPoolMetrics final
+            {
+            public:
+                // the timings are recorded with a relative error of at most 2^-SubBucketBits
+                static constexpr std::uint32_t SubBucketBits = 3;
+
+                explicit ThreadPoolMetrics(std::size_t const numberOfWorkers)
+                    : _waitTime(SubBucketBits)
+                    , _runTime(SubBucketBits)
+                    , _queueDepth(SubBucketBits)
+                    , _blockedTasks(std::make_shared<std::atomic<std::size_t>>(0))
+                {
+                    _workers.reserve(numberOfWorkers);
+                    for (std::size_t i = 0; i < numberOfWorkers; ++i)
+                    {
+                        _workers.emplace_back(std::make_unique<WorkerMetrics>());
+                    }
+                }
+
+                ThreadPoolMetrics(ThreadPoolMetrics const&) = delete;
+                ThreadPoolMetrics(ThreadPoolMetrics&&) = delete;
+                ThreadPoolMetrics& operator=(ThreadPoolMetrics const&) = delete;
+                ThreadPoolMetrics& operator=(ThreadPoolMetrics&&) = delete;
+
+                void Submitted(std::size_t const queueDepth) noexcept
+                {
+                    _submittedTasks.fetch_add(1, std::memory_order_relaxed);
+
+                    auto const blockedTasks = _blockedTasks->load(std::memory_order_relaxed);
+                    _queueDepth.Record(queueDepth - std::min(queueDepth, blockedTasks));
+                }
+
+                // number of queued tasks waiting for their dependencies, shared with the continuations
+                // of the dependencies as they may complete after the thread pool is gone
+                std::shared_ptr<std::atomic<std::size_t>> const& BlockedTasks() const noexcept
+                {
+                    return _blockedTasks;
+                }
+
+                void Executed(std::size_t const worker, std::uint64_t const runnable, std::uint64_t const started, std::uint64_t const finished) noexcept
+                {
+                    auto& metrics = *_workers[worker];
+                    metrics.Add(metrics.executedTasks, 1);
+                    metrics.Add(metrics.busyTime, finished - started);
+
+                    _waitTime.Record(started - std::min(started, runnable));
+                    _runTime.Record(finished - started);
+                }
+
+                void Idle(std::size_t const worker, std::uint64_t const duration) noexcept
+                {
+                    auto& metrics = *_workers[worker];
+                    metrics.Add(metrics.idleTime, duration);
+                }
+
+                void Parked(std::size_t const worker) noexcept
+                {
+                    auto& metrics = *_workers[worker];
+                    metrics.Add(metrics.parks, 1);
+                }
+
+                ThreadPoolMetricsSnapshot Snapshot() const
+                {
+                    ThreadPoolMetricsSnapshot snapshot;
+                    snapshot.enabled = true;
+                    snapshot.submittedTasks = _submittedTasks.load(std::memory_order_relaxed);
+                    snapshot.waitTime = _waitTime.Snapshot();
+                    snapshot.runTime = _runTime.Snapshot();
+                    snapshot.queueDepthOnSubmit = _queueDepth.Snapshot();
+
+                    snapshot.workers.reserve(_workers.size());
+                    for (auto const& worker : _workers)
+                    {
+                        WorkerMetricsSnapshot workerSnapshot;
+                        workerSnapshot.executedTasks = worker->executedTasks.load(std::memory_order_relaxed);
+                        workerSnapshot.busyTime = worker->busyTime.load(std::memory_order_relaxed);
+                        workerSnapshot.idleTime = worker->idleTime.load(std::memory_order_relaxed);
+                        workerSnapshot.parks = worker->parks.load(std::memory_order_relaxed);
+
+                        snapshot.executedTasks += workerSnapshot.executedTasks;
+                        snapshot.workers.push_back(workerSnapshot);
+                    }
+                    return snapshot;
+                }
+
+            private:
+                std::atomic<std::uint64_t> _submittedTasks{ 0 };
+                Histogram _waitTime;
+                Histogram _runTime;
+                Histogram _queueDepth;
+                std::shared_ptr<std::atomic<std::size_t>> _blockedTasks;
+                std::vector<std::unique_ptr<WorkerMetrics>> _workers;
+            };
+        }
+    }
+}
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <azul/async/Future.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/Task.hpp>
+#include <azul/async/detail/TimerWheel.hpp>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        // handle to a periodic timer, copies refer to the same timer
+        class Timer final
+        {
+        public:
+            Timer()
+                : _cancelled(nullptr)
+            {
+
+            }
+
+            explicit Timer(std::shared_ptr<std::atomic<bool>> const& cancelled)
+                : _cancelled(cancelled)
+            {
+
+            }
+
+            bool Valid() const noexcept
+            {
+                return static_cast<bool>(_cancelled);
+            }
+
+            void Cancel()
+            {
+                Check();
+                _cancelled->store(true, std::memory_order_release);
+            }
+
+            bool Cancelled() const
+            {
+                Check();
+                return _cancelled->load(std::memory_order_acquire);
+            }
+
+        private:
+            void Check() const
+            {
+                if (!_cancelled)
+                {
+                    throw std::logic_error("Calling operations on an uninitialized object.");
+                }
+            }
+
+            std::shared_ptr<std::atomic<bool>> _cancelled;
+        };
+
+        // schedules work on a thread pool at a later point in time
+        // all timers are kept in a single hierarchical timer wheel driven by one thread, which only
+        // hands expired work over to the thread pool (see StaticThreadPool::Dispatch) and never waits for it,
+        // work rejected or dropped by a bounded thread pool fails the future of the timer with the error of the pool
+        class TimerService final
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            explicit TimerService(std::shared_ptr<StaticThreadPool> const& executor, std::chrono::milliseconds const resolution = std::chrono::milliseconds(1))
+                : _executor(executor)
+                , _resolution(std::max(std::chrono::duration_cast<Clock::duration>(resolution), Clock::duration(1)))
+                , _start(Clock::now())
+                , _timers(std::make_shared<Timers>())
+            {
+                _thread = std::thread([this]() {
+                    ThreadLoop();
+                });
+            }
+
+            ~TimerService()
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_timers->mutex);
+                    _shutdownInitiated = true;
+                    _condition.notify_all();
+                }
+
+                _thread.join();
+
+                // destroys all pending callbacks (outside of the lock), futures of timers which did not fire report a broken promise
+                detail::TimerWheel<> wheel;
+                {
+                    std::unique_lock<std::mutex> lock(_timers->mutex);
+                    std::swap(wheel, _timers->wheel);
+                }
+            }
+
+            TimerService(TimerService const&) = delete;
+            TimerService(TimerService&&) = delete;
+            TimerService& operator=(TimerService const&) = delete;
+            TimerService& operator=(TimerService&&) = delete;
+
+            template<typename T, typename TResult=std::invoke_result_t<T>>
+            Future<TResult> ExecuteAt(Clock::time_point const& timePoint, T&& callable)
+            {
+                auto newTask = std::make_shared<Task<TResult>>(std::function<TResult()>(callable));
+                auto future = newTask->GetFuture();
+
+                AddTimer(timePoint, [executor = _executor, newTask]() {
+                    detail::OnFailure(executor->Dispatch([newTask]() { newTask->operator()(); }), [newTask](std::exception_ptr const& exception) {
+                        newTask->Fail(exception);
+                    });
+                });
+
+                return future;
+            }
+
+            template<typename T, class Rep, class Period, typename TResult=std::invoke_result_t<T>>
+            Future<TResult> ExecuteAfter(std::chrono::duration<Rep, Period> const& delay, T&& callable)
+            {
+                return ExecuteAt(Clock::now() + std::chrono::duration_cast<Clock::duration>(delay), std::forward<T>(callable));
+            }
+
+            // executes the callable at a fixed rate until the returned timer is cancelled,
+            // executions may overlap if the callable takes longer than the period and are skipped if
+            // a bounded thread pool rejects them
+            template<typename T, class Rep, class Period>
+            Timer ExecuteEvery(std::chrono::duration<Rep, Period> const& period, T&& callable)
+            {
+                auto cancelled = std::make_shared<std::atomic<bool>>(false);
+                auto const clockPeriod = std::max(std::chrono::duration_cast<Clock::duration>(period), _resolution);
+
+                SchedulePeriodic(Clock::now() + clockPeriod, clockPeriod, std::function<void()>(callable), cancelled);
+
+                return Timer(cancelled);
+            }
+
+            // the resulting future either holds the result of the given future or,
+            // if the future is not ready in time, a FutureError(Timeout)
+            template<typename T, class Rep, class Period>
+            Future<T> WithTimeout(Future<T> future, std::chrono::duration<Rep, Period> const& timeout)
+            {
+                auto futureState = std::make_shared<detail::FutureState<T>>();
+                auto futureStateAsPromise = std::shared_ptr<detail::FutureState<T>>(futureState.get(), [futureState](auto*){
+                    futureState->AboutToDestroyPromise();
+                });
+                auto resultFuture = Future<T>(futureState);
+
+                auto completed = std::make_shared<std::atomic<bool>>(false);
+
+                // like every other timer the timeout is completed on the executor and not on the timer thread
+                auto const handle = AddTimer(Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout), [executor = _executor, promise = futureStateAsPromise, completed]() {
+                    if (!completed->exchange(true, std::memory_order_acq_rel))
+                    {
+                        detail::OnFailure(executor->Dispatch([promise]() {
+                            promise->SetException(std::make_exception_ptr(FutureError(FutureErrorCode::Timeout)));
+                        }), [promise](std::exception_ptr const& exception) {
+                            promise->SetException(exception);
+                        });
+                    }
+                });
+
+                // a source completing first removes the timer right away instead of leaving it in the wheel until it expires,
+                // the wheel is only referenced weakly as the source may complete after the service is gone
+                future.Then([promise = std::move(futureStateAsPromise), completed, timers = std::weak_ptr<Timers>(_timers), handle](Future<T> source) {
+                    if (completed->exchange(true, std::memory_order_acq_rel))
+                    {
+                        return;
+                    }
+
+                    if (auto const lockedTimers = timers.lock())
+                    {
+                        lockedTimers->Remove(handle);
+                    }
+                    detail::ForwardResult(source, *promise);
+                });
+
+                return resultFuture;
+            }
+
+            std::size_t PendingTimers() const
+            {
+                std::unique_lock<std::mutex> lock(_timers->mutex);
+                return _timers->wheel.Size();
+            }
+
+        private:
+            // shared with the continuations of WithTimeout, which may outlive the service
+            struct Timers
+            {
+                std::mutex mutex;
+                detail::TimerWheel<> wheel;
+
+                void Remove(detail::TimerWheel<>::Handle const& handle)
+                {
+                    // the callback is destroyed outside of the lock
+                    std::vector<std::function<void()>> removed;
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wheel.Remove(handle, removed);
+                }
+            };
+
+            std::shared_ptr<StaticThreadPool> _executor;
+            Clock::duration const _resolution;
+            Clock::time_point const _start;
+
+            std::condition_variable _condition;
+            std::shared_ptr<Timers> _timers;
+            // tick until which the timer thread currently sleeps
+            std::uint64_t _wakeupTick = std::numeric_limits<std::uint64_t>::max();
+            bool _shutdownInitiated = false;
+
+            std::thread _thread;
+
+            std::uint64_t ToTick(Clock::time_point const& timePoint) const
+            {
+                if (timePoint <= _start)
+                {
+                    return 0;
+                }
+                return static_cast<std::uint64_t>((timePoint - _start) / _resolution);
+            }
+
+            Clock::time_point ToTimePoint(std::uint64_t const tick) const
+            {
+                return _start + _resolution * tick;
+            }
+
+            detail::TimerWheel<>::Handle AddTimer(Clock::time_point const& timePoint, std::function<void()>&& callback)
+            {
+                // rounded up, timers must never fire early
+                auto const expiryTick = ToTick(timePoint - Clock::duration(1)) + 1;
+
+                std::unique_lock<std::mutex> lock(_timers->mutex);
+                auto const handle = _timers->wheel.Add(expiryTick, std::move(callback));
+
+                if (expiryTick < _wakeupTick)
+                {
+                    _condition.notify_one();
+                }
+                return handle;
+            }
+
+            void SchedulePeriodic(Clock::time_point const& timePoint, Clock::duration const& period, std::function<void()>&& callable, std::shared_ptr<std::atomic<bool>> const& cancelled)
+            {
+                AddTimer(timePoint, [this, timePoint, period, callable = std::move(callable), cancelled]() mutable {
+                    if (cancelled->load(std::memory_order_acquire))
+                    {
+                        return;
+                    }
+
+                    _executor->Dispatch(callable);
+                    SchedulePeriodic(timePoint + period, period, std::move(callable), cancelled);
+                });
+            }
+
+            void ThreadLoop()
+            {
+                std::vector<std::function<void()>> expired;
+                std::unique_lock<std::mutex> lock(_timers->mutex);
+
+                while (!_shutdownInitiated)
+                {
+                    _timers->wheel.Advance(ToTick(Clock::now()), expired);
+
+                    if (!expired.empty())
+                    {
+                        lock.unlock();
+                        for (auto& callback : expired)
+                        {
+                            callback();
+                        }
+                        expired.clear();
+                        lock.lock();
+                        continue;
+                    }
+
+                    if (_timers->wheel.Empty())
+                    {
+                        _wakeupTick = std::numeric_limits<std::uint64_t>::max();
+                        _condition.wait(lock);
+                    }
+                    else
+                    {
+                        _wakeupTick = _timers->wheel.NextTick();
+                        _condition.wait_until(lock, ToTimePoint(_wakeupTick));
+                    }
+                }
+            }
+        };
+    }
+}
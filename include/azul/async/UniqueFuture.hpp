@@ -0,0 +1,284 @@
+#pragma once
+
+#include <chrono>
+#include <exception>
+#include <azul/async/Future.hpp>
+#include <azul/async/detail/FutureState.hpp>
+#include <azul/async/detail/UniqueFutureState.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace azul
+{
+    namespace async
+    {
+        template <typename T>
+        class UniquePromise;
+
+        // move only future with exactly one consumer, nothing is reference counted: the state is handed over
+        // between the promise and the future and deleted by whichever side lets go last
+        // the value is moved out by Get (which consumes the future) and moved into continuations
+        template <typename T>
+        class UniqueFuture final
+        {
+        public:
+            UniqueFuture() = default;
+
+            explicit UniqueFuture(detail::UniqueFutureState<T>* state) noexcept
+                : _state(state)
+            {
+
+            }
+
+            ~UniqueFuture()
+            {
+                if (_state)
+                {
+                    _state->Release(detail::UniqueFutureState<T>::FutureReleased);
+                }
+            }
+
+            UniqueFuture(UniqueFuture const&) = delete;
+            UniqueFuture& operator=(UniqueFuture const&) = delete;
+
+            UniqueFuture(UniqueFuture&& other) noexcept
+                : _state(std::exchange(other._state, nullptr))
+            {
+
+            }
+
+            UniqueFuture& operator=(UniqueFuture&& other) noexcept
+            {
+                std::swap(_state, other._state);
+                return *this;
+            }
+
+            bool Valid() const noexcept
+            {
+                return _state != nullptr;
+            }
+
+            bool IsReady() const
+            {
+                Check();
+                return _state->IsReady();
+            }
+
+            void Wait() const
+            {
+                Check();
+                _state->Wait();
+            }
+
+            // always blocks the thread, also on threads with a wait hook (e.g. fibers)
+            template <class Rep, class Period>
+            bool WaitFor(std::chrono::duration<Rep, Period> const& timeoutDuration) const
+            {
+                Check();
+                return _state->WaitFor(timeoutDuration);
+            }
+
+            // waits for the value and moves it out, the future is invalid afterwards
+            T Get()
+            {
+                Check();
+                _state->Wait();
+
+                UniqueFuture owner(std::move(*this));
+                return owner._state->Take();
+            }
+
+            // the callable receives the completed future (and may move the value out of it),
+            // it runs on the thread completing the promise or right away if the value is already there
+            // the future is invalid afterwards, unlike Future::Then the callable may be move only
+            template <typename F>
+            UniqueFuture<std::invoke_result_t<F, UniqueFuture<T>>> Then(F&& callable)
+            {
+                Check();
+
+                using TResult = std::invoke_result_t<F, UniqueFuture<T>>;
+
+                UniquePromise<TResult> promise;
+                auto future = promise.GetFuture();
+
+                auto continuation = detail::UniqueFutureState<T>::MakeContinuation([callable = std::forward<F>(callable), promise = std::move(promise)](detail::UniqueFutureState<T>* completed) mutable {
+                    UniqueFuture<T> antecedent(completed);
+                    try
+                    {
+                        if constexpr (std::is_void_v<TResult>)
+                        {
+                            callable(std::move(antecedent));
+                            promise.SetValue();
+                        }
+                        else
+                        {
+                            promise.SetValue(callable(std::move(antecedent)));
+                        }
+                    }
+                    catch (...)
+                    {
+                        promise.SetException(std::current_exception());
+                    }
+                });
+
+                // the state is only given up once the continuation is allocated, it stays with this future if that throws
+                std::exchange(_state, nullptr)->SetContinuation(std::move(continuation));
+                return future;
+            }
+
+            // converts into a (copyable) Future, the future is invalid afterwards
+            Future<T> Share()
+            {
+                Check();
+
+                Promise<T> promise;
+                auto future = promise.GetFuture();
+
+                Then([promise = std::move(promise)](UniqueFuture<T> completed) mutable {
+                    try
+                    {
+                        if constexpr (std::is_void_v<T>)
+                        {
+                            completed.Get();
+                            promise.SetValue();
+                        }
+                        else
+                        {
+                            promise.SetValue(completed.Get());
+                        }
+                    }
+                    catch (...)
+                    {
+                        promise.SetException(std::current_exception());
+                    }
+                });
+                return future;
+            }
+
+        private:
+            detail::UniqueFutureState<T>* _state = nullptr;
+
+            void Check() const
+            {
+                if (!_state)
+                {
+                    throw std::logic_error("Calling operations on an uninitialized object.");
+                }
+            }
+        };
+
+        // move only promise of a UniqueFuture, destroying it without a result breaks the future
+        template <typename T>
+        class UniquePromise final
+        {
+        public:
+            UniquePromise()
+                : _state(new detail::UniqueFutureState<T>())
+            {
+
+            }
+
+            ~UniquePromise() noexcept
+            {
+                if (!_state)
+                {
+                    return;
+                }
+
+                try
+                {
+                    if (!_satisfied)
+                    {
+                        _state->SetException(std::make_exception_ptr(FutureError(FutureErrorCode::BrokenPromise)));
+                    }
+                }
+                catch (...)
+                {
+                }
+
+                if (!_retrieved)
+                {
+                    _state->Release(detail::UniqueFutureState<T>::FutureReleased);
+                }
+                _state->Release(detail::UniqueFutureState<T>::PromiseReleased);
+            }
+
+            UniquePromise(UniquePromise const&) = delete;
+            UniquePromise& operator=(UniquePromise const&) = delete;
+
+            UniquePromise(UniquePromise&& other) noexcept
+                : _state(std::exchange(other._state, nullptr))
+                , _retrieved(other._retrieved)
+                , _satisfied(other._satisfied)
+            {
+
+            }
+
+            // the promise previously owned by this instance is broken by the destructor of the other one
+            UniquePromise& operator=(UniquePromise&& other) noexcept
+            {
+                std::swap(_state, other._state);
+                std::swap(_retrieved, other._retrieved);
+                std::swap(_satisfied, other._satisfied);
+                return *this;
+            }
+
+            // can only be called once
+            UniqueFuture<T> GetFuture()
+            {
+                Check();
+                if (_retrieved)
+                {
+                    throw std::logic_error("The future has already been retrieved.");
+                }
+
+                _retrieved = true;
+                return UniqueFuture<T>(_state);
+            }
+
+            template <typename F, typename std::enable_if<std::is_convertible_v<F&&, T> && !std::is_void_v<T>>::type* = nullptr>
+            void SetValue(F&& value)
+            {
+                Satisfy();
+                _state->SetValue(std::forward<F>(value));
+            }
+
+            template <typename F = T, typename std::enable_if<std::is_void_v<F>>::type* = nullptr>
+            void SetValue()
+            {
+                Satisfy();
+                _state->SetValue();
+            }
+
+            void SetException(std::exception_ptr const& exception)
+            {
+                Satisfy();
+                _state->SetException(exception);
+            }
+
+        private:
+            detail::UniqueFutureState<T>* _state;
+            bool _retrieved = false;
+            bool _satisfied = false;
+
+            void Check() const
+            {
+                if (!_state)
+                {
+                    throw std::logic_error("Calling operations on an uninitialized object.");
+                }
+            }
+
+            void Satisfy()
+            {
+                Check();
+                if (_satisfied)
+                {
+                    throw FutureError(FutureErrorCode::FutureAlreadySet);
+                }
+                _satisfied = true;
+            }
+        };
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            // hint for the processor that the caller is busy waiting, lowers the power consumption of the spin
+            // and frees execution resources for the sibling hyper thread without giving up the time slice
+            inline void CpuRelax() noexcept
+            {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+                _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+                asm volatile("yield" ::: "memory");
+#endif
+            }
+        }
+    }
+}
@@ -2,8 +2,14 @@
 
 #include <chrono>
 #include <condition_variable>
+#include <azul/async/detail/Trampoline.hpp>
+#include <azul/async/detail/WaitHook.hpp>
+#include <functional>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <stdexcept>
+#include <vector>
 
 namespace azul
 {
@@ -12,7 +18,10 @@ namespace azul
         enum class FutureErrorCode : std::uint32_t
         {
             BrokenPromise = 0,
-            FutureAlreadySet = 1
+            FutureAlreadySet = 1,
+            QueueFull = 2,
+            Timeout = 3,
+            ChannelClosed = 4
         };
 
         class FutureError : public std::exception
@@ -40,7 +49,8 @@ namespace azul
             class FutureState
             {
             public:
-                explicit FutureState()
+                explicit FutureState(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                    : _continuations(resource)
                 {
 
                 }
@@ -71,7 +81,7 @@ namespace azul
                         case State::Ready:
                             return _value;
                         case State::Undefined:
-                            _condition.wait(lock);
+                            WaitUntilCompleted(lock);
                             break;
                         }
                     }
@@ -88,12 +98,12 @@ namespace azul
 
                         _value = value;
                         _state = State::Ready;
-                        _condition.notify_all();
+                        NotifyWaiters();
                     }
 
                     for (const auto& continuation : _continuations)
                     {
-                        continuation();
+                        Trampoline::Dispatch(continuation);
                     }
                 }
 
@@ -103,22 +113,54 @@ namespace azul
                         std::lock_guard<std::mutex> lock(_mutex);
                         _exception = ex;
                         _state = State::Exception;
-                        _condition.notify_all();
+                        NotifyWaiters();
                     }
 
                     for (const auto& continuation : _continuations)
                     {
-                        continuation();
+                        Trampoline::Dispatch(continuation);
+                    }
+                }
+
+                // publishes the value unless the state is already completed, the continuations to run are appended
+                // to the given vector instead of being dispatched, false if the state was already completed
+                bool TrySetValue(T const& value, std::vector<std::function<void()>>& continuations)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_state != State::Undefined)
+                    {
+                        return false;
+                    }
+
+                    _value = value;
+                    _state = State::Ready;
+                    NotifyWaiters();
+                    TakeContinuations(continuations);
+                    return true;
+                }
+
+                bool TrySetException(std::exception_ptr const& ex, std::vector<std::function<void()>>& continuations)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_state != State::Undefined)
+                    {
+                        return false;
                     }
+
+                    _exception = ex;
+                    _state = State::Exception;
+                    NotifyWaiters();
+                    TakeContinuations(continuations);
+                    return true;
                 }
 
                 void Wait()
                 {
                     std::unique_lock<std::mutex> lock(_mutex);
 
-                    if (_state == State::Undefined)
+                    while (_state == State::Undefined)
                     {
-                        _condition.wait(lock);
+                        WaitUntilCompleted(lock);
                     }
                 }
 
@@ -126,9 +168,17 @@ namespace azul
                 bool WaitFor(std::chrono::duration<Rep,Period> const& timeoutDuration) const
                 {
                     std::unique_lock<std::mutex> lock(_mutex);
+                    if (_state == State::Undefined && RunPendingBeforeBlocking(lock))
+                    {
+                        return true;
+                    }
+
                     if (_state == State::Undefined)
                     {
-                        return _condition.wait_for(lock, timeoutDuration) != std::cv_status::timeout;
+                        ++_waiters;
+                        auto const status = _condition.wait_for(lock, timeoutDuration);
+                        --_waiters;
+                        return status != std::cv_status::timeout;
                     }
                     return true;
                 }
@@ -153,6 +203,12 @@ namespace azul
                     return _continuations.size();
                 }
 
+                // memory resource the state was allocated from, states derived from this one use it as well
+                std::pmr::memory_resource* Resource() const noexcept
+                {
+                    return _continuations.get_allocator().resource();
+                }
+
                 void AboutToDestroyPromise()
                 {
                     {
@@ -161,15 +217,75 @@ namespace azul
                         {
                             _state = State::BrokenPromise;
                         }
-                        _condition.notify_all();
+                        NotifyWaiters();
                     }
 
                     _continuations.clear();
                 }
 
             private:
+                // suspends the caller through the wait hook of the thread (if any) instead of blocking it,
+                // the wake function is destroyed without being invoked if the promise is broken
+                void WaitUntilCompleted(std::unique_lock<std::mutex>& lock)
+                {
+                    if (RunPendingBeforeBlocking(lock))
+                    {
+                        return;
+                    }
+
+                    auto const hook = WaitHook::Current();
+                    if (!hook)
+                    {
+                        ++_waiters;
+                        _condition.wait(lock);
+                        --_waiters;
+                        return;
+                    }
+
+                    lock.unlock();
+                    hook->Suspend([this](WaitHook::WakeFunction const& wake) {
+                        Then(wake);
+                    });
+                    lock.lock();
+                }
+
+                // continuations queued on this thread might produce the awaited result, they run (without the lock held)
+                // only right before blocking, true if the state got completed by them
+                bool RunPendingBeforeBlocking(std::unique_lock<std::mutex>& lock) const
+                {
+                    if (!Trampoline::HasPending())
+                    {
+                        return false;
+                    }
+
+                    lock.unlock();
+                    Trampoline::RunPending();
+                    lock.lock();
+                    return _state != State::Undefined;
+                }
+
+                // only threads blocked in a wait are notified, completing a promise nobody waits for skips the broadcast
+                void NotifyWaiters()
+                {
+                    if (_waiters > 0)
+                    {
+                        _condition.notify_all();
+                    }
+                }
+
+                // continuations are handed to the caller instead of being dispatched (used for bulk completion)
+                void TakeContinuations(std::vector<std::function<void()>>& continuations)
+                {
+                    for (auto& continuation : _continuations)
+                    {
+                        continuations.emplace_back(std::move(continuation));
+                    }
+                    _continuations.clear();
+                }
+
                 mutable std::condition_variable _condition;
                 mutable std::mutex _mutex;
+                mutable std::size_t _waiters = 0;
 
                 enum class State
                 {
@@ -183,14 +299,15 @@ namespace azul
                 T _value{ };
                 std::exception_ptr _exception{ };
 
-                std::vector<std::function<void()>> _continuations;
+                std::pmr::vector<std::function<void()>> _continuations;
             };
 
             template <>
             class FutureState<void>
             {
             public:
-                explicit FutureState()
+                explicit FutureState(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                    : _continuations(resource)
                 {
 
                 }
@@ -221,7 +338,7 @@ namespace azul
                         case State::Ready:
                             return;
                         case State::Undefined:
-                            _condition.wait(lock);
+                            WaitUntilCompleted(lock);
                             break;
                         }
                     }
@@ -237,12 +354,12 @@ namespace azul
                         }
                         
                         _state = State::Ready;
-                        _condition.notify_all();
+                        NotifyWaiters();
                     }
 
                     for (const auto& continuation : _continuations)
                     {
-                        continuation();
+                        Trampoline::Dispatch(continuation);
                     }
                 }
 
@@ -252,32 +369,71 @@ namespace azul
                         std::lock_guard<std::mutex> lock(_mutex);
                         _exception = ex;
                         _state = State::Exception;
-                        _condition.notify_all();
+                        NotifyWaiters();
                     }
 
                     for (const auto& continuation : _continuations)
                     {
-                        continuation();
+                        Trampoline::Dispatch(continuation);
                     }
                 }
+
+                // publishes the value unless the state is already completed, the continuations to run are appended
+                // to the given vector instead of being dispatched, false if the state was already completed
+                bool TrySetValue(std::vector<std::function<void()>>& continuations)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_state != State::Undefined)
+                    {
+                        return false;
+                    }
+
+                    _state = State::Ready;
+                    NotifyWaiters();
+                    TakeContinuations(continuations);
+                    return true;
+                }
+
+                bool TrySetException(std::exception_ptr const& ex, std::vector<std::function<void()>>& continuations)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_state != State::Undefined)
+                    {
+                        return false;
+                    }
+
+                    _exception = ex;
+                    _state = State::Exception;
+                    NotifyWaiters();
+                    TakeContinuations(continuations);
+                    return true;
+                }
             
 
                 void Wait()
                 {
                     std::unique_lock<std::mutex> lock(_mutex);
-                    if (_state == State::Undefined)
+                    while (_state == State::Undefined)
                     {
-                        _condition.wait(lock);
+                        WaitUntilCompleted(lock);
                     }
                 }
 
                 template<class Rep, class Period>
-                bool wait_for(std::chrono::duration<Rep,Period> const& timeoutDuration) const
+                bool WaitFor(std::chrono::duration<Rep,Period> const& timeoutDuration) const
                 {
                     std::unique_lock<std::mutex> lock(_mutex);
+                    if (_state == State::Undefined && RunPendingBeforeBlocking(lock))
+                    {
+                        return true;
+                    }
+
                     if (_state == State::Undefined)
                     {
-                        return _condition.wait_for(lock, timeoutDuration) != std::cv_status::timeout;
+                        ++_waiters;
+                        auto const status = _condition.wait_for(lock, timeoutDuration);
+                        --_waiters;
+                        return status != std::cv_status::timeout;
                     }
                     return true;
                 }
@@ -302,6 +458,12 @@ namespace azul
                     return _continuations.size();
                 }
 
+                // memory resource the state was allocated from, states derived from this one use it as well
+                std::pmr::memory_resource* Resource() const noexcept
+                {
+                    return _continuations.get_allocator().resource();
+                }
+
                 void AboutToDestroyPromise()
                 {
                     {
@@ -310,15 +472,75 @@ namespace azul
                         {
                             _state = State::BrokenPromise;
                         }
-                        _condition.notify_all();
+                        NotifyWaiters();
                     }
 
                     _continuations.clear();
                 }
 
             private:
+                // suspends the caller through the wait hook of the thread (if any) instead of blocking it,
+                // the wake function is destroyed without being invoked if the promise is broken
+                void WaitUntilCompleted(std::unique_lock<std::mutex>& lock)
+                {
+                    if (RunPendingBeforeBlocking(lock))
+                    {
+                        return;
+                    }
+
+                    auto const hook = WaitHook::Current();
+                    if (!hook)
+                    {
+                        ++_waiters;
+                        _condition.wait(lock);
+                        --_waiters;
+                        return;
+                    }
+
+                    lock.unlock();
+                    hook->Suspend([this](WaitHook::WakeFunction const& wake) {
+                        Then(wake);
+                    });
+                    lock.lock();
+                }
+
+                // continuations queued on this thread might produce the awaited result, they run (without the lock held)
+                // only right before blocking, true if the state got completed by them
+                bool RunPendingBeforeBlocking(std::unique_lock<std::mutex>& lock) const
+                {
+                    if (!Trampoline::HasPending())
+                    {
+                        return false;
+                    }
+
+                    lock.unlock();
+                    Trampoline::RunPending();
+                    lock.lock();
+                    return _state != State::Undefined;
+                }
+
+                // only threads blocked in a wait are notified, completing a promise nobody waits for skips the broadcast
+                void NotifyWaiters()
+                {
+                    if (_waiters > 0)
+                    {
+                        _condition.notify_all();
+                    }
+                }
+
+                // continuations are handed to the caller instead of being dispatched (used for bulk completion)
+                void TakeContinuations(std::vector<std::function<void()>>& continuations)
+                {
+                    for (auto& continuation : _continuations)
+                    {
+                        continuations.emplace_back(std::move(continuation));
+                    }
+                    _continuations.clear();
+                }
+
                 mutable std::condition_variable _condition;
                 mutable std::mutex _mutex;
+                mutable std::size_t _waiters = 0;
 
                 enum class State
                 {
@@ -331,8 +553,14 @@ namespace azul
                 State _state{ State::Undefined };
                 std::exception_ptr _exception{ };
 
-                std::vector<std::function<void()>> _continuations;
+                std::pmr::vector<std::function<void()>> _continuations;
             };
+
+            template <typename T>
+            std::shared_ptr<FutureState<T>> MakeFutureState(std::pmr::memory_resource* resource)
+            {
+                return std::allocate_shared<FutureState<T>>(std::pmr::polymorphic_allocator<FutureState<T>>(resource), resource);
+            }
         }
     }
 }
\ No newline at end of file
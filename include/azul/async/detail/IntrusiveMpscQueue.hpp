@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            struct IntrusiveMpscNode
+            {
+                std::atomic<IntrusiveMpscNode*> next{ nullptr };
+            };
+
+            // intrusive variant of MpscQueue (Dmitry Vyukov's algorithm with an embedded stub node)
+            // the nodes are the queued objects themselves, so pushing does not allocate and an empty queue
+            // costs three pointers, which makes it suitable for a very large number of mostly idle queues
+            // the queue owns the pushed nodes (allocated with new), nodes left on destruction are deleted
+            template <typename T>
+            class IntrusiveMpscQueue final
+            {
+            public:
+                IntrusiveMpscQueue()
+                    : _head(&_stub)
+                    , _tail(&_stub)
+                {
+
+                }
+
+                ~IntrusiveMpscQueue()
+                {
+                    while (auto node = TryPop())
+                    {
+                        delete node;
+                    }
+                }
+
+                IntrusiveMpscQueue(IntrusiveMpscQueue const&) = delete;
+                IntrusiveMpscQueue(IntrusiveMpscQueue&&) = delete;
+                IntrusiveMpscQueue& operator=(IntrusiveMpscQueue const&) = delete;
+                IntrusiveMpscQueue& operator=(IntrusiveMpscQueue&&) = delete;
+
+                // may be called concurrently from any number of threads
+                void Push(T* node) noexcept
+                {
+                    PushNode(node);
+                }
+
+                // must only be called by a single consumer at a time
+                // nullptr does not guarantee that the queue is empty: a producer may have
+                // published its node without having linked it yet
+                T* TryPop() noexcept
+                {
+                    auto tail = _tail;
+                    auto next = tail->next.load(std::memory_order_acquire);
+
+                    if (tail == &_stub)
+                    {
+                        if (!next)
+                        {
+                            return nullptr;
+                        }
+                        _tail = next;
+                        tail = next;
+                        next = next->next.load(std::memory_order_acquire);
+                    }
+
+                    if (next)
+                    {
+                        _tail = next;
+                        return static_cast<T*>(tail);
+                    }
+
+                    if (tail != _head.load(std::memory_order_acquire))
+                    {
+                        return nullptr;
+                    }
+
+                    // the last node can only be handed out once the stub is queued behind it
+                    PushNode(&_stub);
+
+                    next = tail->next.load(std::memory_order_acquire);
+                    if (next)
+                    {
+                        _tail = next;
+                        return static_cast<T*>(tail);
+                    }
+                    return nullptr;
+                }
+
+            private:
+                std::atomic<IntrusiveMpscNode*> _head;
+                IntrusiveMpscNode* _tail;
+                IntrusiveMpscNode _stub;
+
+                void PushNode(IntrusiveMpscNode* node) noexcept
+                {
+                    node->next.store(nullptr, std::memory_order_relaxed);
+                    auto previous = _head.exchange(node, std::memory_order_acq_rel);
+                    previous->next.store(node, std::memory_order_release);
+                }
+            };
+        }
+    }
+}
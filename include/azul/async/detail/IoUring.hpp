@@ -0,0 +1,216 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            // minimal io_uring wrapper on top of the raw syscalls (no liburing dependency)
+            // not thread safe, the submission and completion queues are meant to be driven by a single thread
+            class IoUring final
+            {
+            public:
+                explicit IoUring(std::uint32_t const entries)
+                {
+                    io_uring_params params;
+                    std::memset(&params, 0, sizeof(params));
+
+                    _fd = static_cast<int>(::syscall(__NR_io_uring_setup, std::max<std::uint32_t>(entries, 2u), &params));
+                    if (_fd < 0)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "io_uring_setup");
+                    }
+
+                    _features = params.features;
+
+                    try
+                    {
+                        Map(params);
+                    }
+                    catch (...)
+                    {
+                        Unmap();
+                        ::close(_fd);
+                        throw;
+                    }
+                }
+
+                ~IoUring()
+                {
+                    Unmap();
+                    ::close(_fd);
+                }
+
+                IoUring(IoUring const&) = delete;
+                IoUring(IoUring&&) = delete;
+                IoUring& operator=(IoUring const&) = delete;
+                IoUring& operator=(IoUring&&) = delete;
+
+                std::uint32_t Capacity() const noexcept
+                {
+                    return _sqEntries;
+                }
+
+                // IORING_FEAT_* flags reported by the kernel
+                std::uint32_t Features() const noexcept
+                {
+                    return _features;
+                }
+
+                // the entry is cleared, nullptr if the submission queue is full
+                io_uring_sqe* TryGetSqe() noexcept
+                {
+                    auto const head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+                    if (_sqTail - head >= _sqEntries)
+                    {
+                        return nullptr;
+                    }
+
+                    auto const index = _sqTail & _sqMask;
+                    auto* sqe = &_sqes[index];
+                    std::memset(sqe, 0, sizeof(*sqe));
+                    _sqArray[index] = index;
+                    ++_sqTail;
+                    return sqe;
+                }
+
+                // publishes the prepared entries and submits up to toSubmit of them in a single syscall,
+                // returns the number of submitted entries or -errno
+                int Enter(std::uint32_t const toSubmit, std::uint32_t const minComplete)
+                {
+                    __atomic_store_n(_sqTailShared, _sqTail, __ATOMIC_RELEASE);
+
+                    auto const flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0u;
+                    auto const result = ::syscall(__NR_io_uring_enter, _fd, toSubmit, minComplete, flags, nullptr, 0);
+                    return result < 0 ? -errno : static_cast<int>(result);
+                }
+
+                template <typename F>
+                std::uint32_t ForEachCompletion(F&& callable)
+                {
+                    auto head = *_cqHead;
+                    auto const tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+
+                    std::uint32_t count = 0;
+                    for (; head != tail; ++head, ++count)
+                    {
+                        callable(_cqes[head & _cqMask]);
+                    }
+
+                    __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+                    return count;
+                }
+
+                bool RegisterBuffers(iovec const* buffers, std::uint32_t const count)
+                {
+                    return ::syscall(__NR_io_uring_register, _fd, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+                }
+
+            private:
+                int _fd = -1;
+                std::uint32_t _features = 0;
+
+                void* _sqRing = MAP_FAILED;
+                std::size_t _sqRingSize = 0;
+                void* _cqRing = MAP_FAILED;
+                std::size_t _cqRingSize = 0;
+                io_uring_sqe* _sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+                std::size_t _sqesSize = 0;
+
+                std::uint32_t* _sqHead = nullptr;
+                std::uint32_t* _sqTailShared = nullptr;
+                std::uint32_t* _sqArray = nullptr;
+                std::uint32_t _sqMask = 0;
+                std::uint32_t _sqEntries = 0;
+                // entries are prepared locally and only published by Enter
+                std::uint32_t _sqTail = 0;
+
+                std::uint32_t* _cqHead = nullptr;
+                std::uint32_t* _cqTail = nullptr;
+                io_uring_cqe* _cqes = nullptr;
+                std::uint32_t _cqMask = 0;
+
+                void Map(io_uring_params const& params)
+                {
+                    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+                    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+                    // newer kernels map both rings with a single mmap
+                    bool const singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                    if (singleMap)
+                    {
+                        _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+                    }
+
+                    _sqRing = ::mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+                    if (_sqRing == MAP_FAILED)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "mmap");
+                    }
+
+                    if (!singleMap)
+                    {
+                        _cqRing = ::mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+                        if (_cqRing == MAP_FAILED)
+                        {
+                            throw std::system_error(errno, std::generic_category(), "mmap");
+                        }
+                    }
+
+                    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                    _sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES));
+                    if (_sqes == MAP_FAILED)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "mmap");
+                    }
+
+                    auto* sq = static_cast<std::uint8_t*>(_sqRing);
+                    _sqHead = reinterpret_cast<std::uint32_t*>(sq + params.sq_off.head);
+                    _sqTailShared = reinterpret_cast<std::uint32_t*>(sq + params.sq_off.tail);
+                    _sqArray = reinterpret_cast<std::uint32_t*>(sq + params.sq_off.array);
+                    _sqMask = *reinterpret_cast<std::uint32_t*>(sq + params.sq_off.ring_mask);
+                    _sqEntries = *reinterpret_cast<std::uint32_t*>(sq + params.sq_off.ring_entries);
+                    _sqTail = *_sqTailShared;
+
+                    auto* cq = static_cast<std::uint8_t*>(singleMap ? _sqRing : _cqRing);
+                    _cqHead = reinterpret_cast<std::uint32_t*>(cq + params.cq_off.head);
+                    _cqTail = reinterpret_cast<std::uint32_t*>(cq + params.cq_off.tail);
+                    _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+                    _cqMask = *reinterpret_cast<std::uint32_t*>(cq + params.cq_off.ring_mask);
+                }
+
+                void Unmap() noexcept
+                {
+                    if (_sqes != MAP_FAILED)
+                    {
+                        ::munmap(_sqes, _sqesSize);
+                    }
+                    if (_cqRing != MAP_FAILED)
+                    {
+                        ::munmap(_cqRing, _cqRingSize);
+                    }
+                    if (_sqRing != MAP_FAILED)
+                    {
+                        ::munmap(_sqRing, _sqRingSize);
+                    }
+                }
+            };
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            // unbounded multi-producer/single-consumer queue (Dmitry Vyukov's node based algorithm)
+            // producers only need a single atomic exchange, the consumer does not use any atomic read-modify-write operations
+            template <typename T>
+            class MpscQueue final
+            {
+            public:
+                MpscQueue()
+                    : _head(new Node())
+                {
+                    _tail = _head.load(std::memory_order_relaxed);
+                }
+
+                ~MpscQueue()
+                {
+                    while (TryPop())
+                    {
+                    }
+                    delete _tail;
+                }
+
+                MpscQueue(MpscQueue const&) = delete;
+                MpscQueue(MpscQueue&&) = delete;
+                MpscQueue& operator=(MpscQueue const&) = delete;
+                MpscQueue& operator=(MpscQueue&&) = delete;
+
+                // may be called concurrently from any number of threads
+                void Push(T value)
+                {
+                    auto node = new Node();
+                    node->value.emplace(std::move(value));
+
+                    auto previous = _head.exchange(node, std::memory_order_acq_rel);
+                    previous->next.store(node, std::memory_order_release);
+                }
+
+                // must only be called by a single consumer at a time
+                // an empty result does not guarantee that the queue is empty: a producer may have
+                // published its node without having linked it yet
+                std::optional<T> TryPop()
+                {
+                    auto tail = _tail;
+                    auto next = tail->next.load(std::memory_order_acquire);
+                    if (!next)
+                    {
+                        return {};
+                    }
+
+                    std::optional<T> result(std::move(next->value));
+                    next->value.reset();
+
+                    _tail = next;
+                    delete tail;
+                    return result;
+                }
+
+                bool Empty() const
+                {
+                    return _tail->next.load(std::memory_order_acquire) == nullptr;
+                }
+
+            private:
+                struct Node
+                {
+                    std::atomic<Node*> next{ nullptr };
+                    std::optional<T> value{ };
+                };
+
+                alignas(64) std::atomic<Node*> _head;
+                alignas(64) Node* _tail;
+            };
+        }
+    }
+}
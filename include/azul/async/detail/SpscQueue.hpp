@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            // bounded single-producer/single-consumer ring buffer
+            // both sides cache the index of the other side and only touch its cache line if the cached value
+            // suggests that the queue is full (producer) or empty (consumer)
+            template <typename T>
+            class SpscQueue final
+            {
+            public:
+                // the capacity is rounded up to the next power of two
+                explicit SpscQueue(std::size_t const capacity)
+                    : _slots(RoundUpToPowerOfTwo(capacity))
+                    , _mask(_slots.size() - 1)
+                {
+
+                }
+
+                SpscQueue(SpscQueue const&) = delete;
+                SpscQueue(SpscQueue&&) = delete;
+                SpscQueue& operator=(SpscQueue const&) = delete;
+                SpscQueue& operator=(SpscQueue&&) = delete;
+
+                std::size_t Capacity() const noexcept
+                {
+                    return _slots.size();
+                }
+
+                // must only be called by the producer, the value is not consumed if the queue is full
+                bool TryPush(T&& value)
+                {
+                    auto const tail = _tail.load(std::memory_order_relaxed);
+                    if (tail - _cachedHead == _slots.size())
+                    {
+                        _cachedHead = _head.load(std::memory_order_acquire);
+                        if (tail - _cachedHead == _slots.size())
+                        {
+                            return false;
+                        }
+                    }
+
+                    _slots[tail & _mask].emplace(std::move(value));
+                    _tail.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+
+                // must only be called by the consumer
+                std::optional<T> TryPop()
+                {
+                    auto const head = _head.load(std::memory_order_relaxed);
+                    if (head == _cachedTail)
+                    {
+                        _cachedTail = _tail.load(std::memory_order_acquire);
+                        if (head == _cachedTail)
+                        {
+                            return std::nullopt;
+                        }
+                    }
+
+                    auto& slot = _slots[head & _mask];
+                    std::optional<T> result(std::move(slot));
+                    slot.reset();
+                    _head.store(head + 1, std::memory_order_release);
+                    return result;
+                }
+
+            private:
+                std::vector<std::optional<T>> _slots;
+                std::size_t const _mask;
+
+                // consumer side
+                alignas(64) std::atomic<std::size_t> _head{ 0 };
+                std::size_t _cachedTail = 0;
+
+                // producer side
+                alignas(64) std::atomic<std::size_t> _tail{ 0 };
+                std::size_t _cachedHead = 0;
+
+                static std::size_t RoundUpToPowerOfTwo(std::size_t const value) noexcept
+                {
+                    std::size_t result = 1;
+                    while (result < value)
+                    {
+                        result <<= 1;
+                    }
+                    return result;
+                }
+            };
+        }
+    }
+}
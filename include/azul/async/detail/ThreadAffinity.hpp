@@ -0,0 +1,31 @@
+#pragma once
+
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            // pins the thread to the given core, only supported on linux and silently ignored elsewhere
+            inline void PinThread(std::thread& thread, int const cpu)
+            {
+#if defined(__linux__)
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                ::pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set);
+#else
+                (void)thread;
+                (void)cpu;
+#endif
+            }
+        }
+    }
+}
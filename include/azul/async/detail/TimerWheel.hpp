@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            // hierarchical timing wheel (Varghese & Lauck) operating on abstract ticks
+            // insertion and expiry are O(1), timers far in the future are cascaded down to lower levels
+            // once their expiry comes close, the class itself is not thread safe
+            template <typename TCallback = std::function<void()>>
+            class TimerWheel final
+            {
+            public:
+                // identifies an added timer for Remove
+                struct Handle
+                {
+                    std::uint64_t expiryTick;
+                    std::uint64_t id;
+                };
+
+                explicit TimerWheel(std::uint64_t const currentTick = 0)
+                    : _currentTick(currentTick)
+                {
+
+                }
+
+                std::uint64_t CurrentTick() const noexcept
+                {
+                    return _currentTick;
+                }
+
+                std::size_t Size() const noexcept
+                {
+                    return _size;
+                }
+
+                bool Empty() const noexcept
+                {
+                    return _size == 0;
+                }
+
+                // timers which already expired fire on the next advanced tick
+                Handle Add(std::uint64_t const expiryTick, TCallback&& callback)
+                {
+                    Handle const handle{ std::max(expiryTick, _currentTick + 1), _nextId++ };
+                    Place(Entry{ handle.expiryTick, handle.id, std::move(callback) });
+                    ++_size;
+                    return handle;
+                }
+
+                // removes a timer which did not fire yet and appends its callback (without invoking it) to removed
+                // only the slot matching the expiry on each level and the overflow can hold the timer
+                bool Remove(Handle const& handle, std::vector<TCallback>& removed)
+                {
+                    for (std::uint32_t level = 0; level < LevelCount; ++level)
+                    {
+                        if (Erase(_levels[level][(handle.expiryTick >> (SlotBits * level)) & SlotMask], handle.id, removed))
+                        {
+                            return true;
+                        }
+                    }
+                    return Erase(_overflow, handle.id, removed);
+                }
+
+                // advances the wheel up to (and including) the given tick and appends all expired callbacks
+                void Advance(std::uint64_t const tick, std::vector<TCallback>& expired)
+                {
+                    while (_currentTick < tick && _size > 0)
+                    {
+                        ++_currentTick;
+                        Cascade();
+
+                        auto& slot = _levels[0][_currentTick & SlotMask];
+                        for (auto& entry : slot)
+                        {
+                            expired.emplace_back(std::move(entry.callback));
+                        }
+                        _size -= slot.size();
+                        slot.clear();
+                    }
+
+                    // nothing left to expire, skip the remaining ticks entirely
+                    _currentTick = std::max(_currentTick, tick);
+                }
+
+                // earliest tick at which the wheel has to be advanced again,
+                // either because a timer expires or because higher levels have to be cascaded
+                std::uint64_t NextTick() const noexcept
+                {
+                    auto const rotationEnd = (_currentTick | SlotMask) + 1;
+                    for (auto tick = _currentTick + 1; tick < rotationEnd; ++tick)
+                    {
+                        if (!_levels[0][tick & SlotMask].empty())
+                        {
+                            return tick;
+                        }
+                    }
+                    return rotationEnd;
+                }
+
+            private:
+                static constexpr std::uint32_t SlotBits = 6;
+                static constexpr std::uint32_t SlotCount = 1u << SlotBits;
+                static constexpr std::uint64_t SlotMask = SlotCount - 1;
+                static constexpr std::uint32_t LevelCount = 4;
+
+                struct Entry
+                {
+                    std::uint64_t expiryTick;
+                    std::uint64_t id;
+                    TCallback callback;
+                };
+
+                std::array<std::array<std::vector<Entry>, SlotCount>, LevelCount> _levels;
+                // timers beyond the range of the highest level
+                std::vector<Entry> _overflow;
+
+                std::uint64_t _currentTick;
+                std::size_t _size = 0;
+                std::uint64_t _nextId = 0;
+
+                bool Erase(std::vector<Entry>& entries, std::uint64_t const id, std::vector<TCallback>& removed)
+                {
+                    auto const it = std::find_if(entries.begin(), entries.end(), [id](auto const& entry) { return entry.id == id; });
+                    if (it == entries.end())
+                    {
+                        return false;
+                    }
+
+                    removed.emplace_back(std::move(it->callback));
+                    entries.erase(it);
+                    --_size;
+                    return true;
+                }
+
+                void Place(Entry&& entry)
+                {
+                    auto const delta = entry.expiryTick - _currentTick;
+
+                    for (std::uint32_t level = 0; level < LevelCount; ++level)
+                    {
+                        if (delta < (std::uint64_t{ 1 } << (SlotBits * (level + 1))))
+                        {
+                            auto const slot = (entry.expiryTick >> (SlotBits * level)) & SlotMask;
+                            _levels[level][slot].emplace_back(std::move(entry));
+                            return;
+                        }
+                    }
+
+                    _overflow.emplace_back(std::move(entry));
+                }
+
+                void Cascade()
+                {
+                    for (std::uint32_t level = 1; level < LevelCount; ++level)
+                    {
+                        if (((_currentTick >> (SlotBits * (level - 1))) & SlotMask) != 0)
+                        {
+                            return;
+                        }
+
+                        auto entries = std::move(_levels[level][(_currentTick >> (SlotBits * level)) & SlotMask]);
+                        _levels[level][(_currentTick >> (SlotBits * level)) & SlotMask].clear();
+                        for (auto& entry : entries)
+                        {
+                            Place(std::move(entry));
+                        }
+                    }
+
+                    if (((_currentTick >> (SlotBits * (LevelCount - 1))) & SlotMask) == 0)
+                    {
+                        auto entries = std::move(_overflow);
+                        _overflow.clear();
+                        for (auto& entry : entries)
+                        {
+                            Place(std::move(entry));
+                        }
+                    }
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <deque>
+#include <exception>
+#include <functional>
+#include <utility>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            // per thread trampoline for continuations
+            // a continuation dispatched while another continuation is running on the same thread is queued
+            // and executed after the running one returned, completing a long chain of futures therefore
+            // is processed iteratively instead of recursing once per link
+            class Trampoline final
+            {
+            public:
+                template <typename F>
+                static void Dispatch(F const& continuation)
+                {
+                    auto& local = Local();
+                    if (local.dispatching)
+                    {
+                        local.pending.emplace_back(continuation);
+                        return;
+                    }
+
+                    local.dispatching = true;
+
+                    std::exception_ptr firstException;
+                    Run(continuation, firstException);
+                    RunPending(local, firstException);
+
+                    local.dispatching = false;
+
+                    if (firstException)
+                    {
+                        std::rethrow_exception(firstException);
+                    }
+                }
+
+                static bool HasPending() noexcept
+                {
+                    return !Local().pending.empty();
+                }
+
+                // executes all continuations queued on this thread, called right before a thread blocks
+                // on a future because the result might be produced by one of the queued continuations
+                static void RunPending()
+                {
+                    auto& local = Local();
+                    if (local.pending.empty())
+                    {
+                        return;
+                    }
+
+                    std::exception_ptr firstException;
+                    RunPending(local, firstException);
+
+                    if (firstException)
+                    {
+                        std::rethrow_exception(firstException);
+                    }
+                }
+
+                // trampoline state of one call stack, executors running several stacks on the same thread
+                // (e.g. fibers) exchange it whenever they switch stacks
+                struct Context
+                {
+                    bool dispatching = false;
+                    std::deque<std::function<void()>> pending;
+                };
+
+                static void SwapContext(Context& other) noexcept
+                {
+                    std::swap(Local(), other);
+                }
+
+            private:
+                static Context& Local()
+                {
+                    static thread_local Context state;
+                    return state;
+                }
+
+                template <typename F>
+                static void Run(F const& continuation, std::exception_ptr& firstException)
+                {
+                    try
+                    {
+                        continuation();
+                    }
+                    catch(...)
+                    {
+                        if (!firstException)
+                        {
+                            firstException = std::current_exception();
+                        }
+                    }
+                }
+
+                static void RunPending(Context& local, std::exception_ptr& firstException)
+                {
+                    while (!local.pending.empty())
+                    {
+                        auto continuation = std::move(local.pending.front());
+                        local.pending.pop_front();
+                        Run(continuation, firstException);
+                    }
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <azul/async/detail/Trampoline.hpp>
+#include <azul/async/detail/WaitHook.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            template <typename T>
+            class UniqueFutureState;
+
+            template <typename T>
+            struct UniqueContinuation
+            {
+                virtual ~UniqueContinuation() = default;
+                virtual void Run(UniqueFutureState<T>* state) = 0;
+            };
+
+            template <typename T, typename F>
+            struct UniqueContinuationImpl final : UniqueContinuation<T>
+            {
+                explicit UniqueContinuationImpl(F&& continuation)
+                    : function(std::move(continuation))
+                {
+
+                }
+
+                void Run(UniqueFutureState<T>* state) override
+                {
+                    function(state);
+                }
+
+                F function;
+            };
+
+            // state shared by exactly one producer and one consumer, it is neither reference counted nor locked:
+            // a single status word tells whether the value is published, whether a continuation is attached and
+            // which side already let go of the state (the second one deletes it)
+            // the mutex and condition are only used by consumers blocking in Wait
+            template <typename T>
+            class UniqueFutureState final
+            {
+            public:
+                static constexpr std::uint32_t Ready = 1u;
+                static constexpr std::uint32_t HasContinuation = 2u;
+                static constexpr std::uint32_t HasWaiter = 4u;
+                static constexpr std::uint32_t PromiseReleased = 8u;
+                static constexpr std::uint32_t FutureReleased = 16u;
+
+                UniqueFutureState() = default;
+
+                UniqueFutureState(UniqueFutureState const&) = delete;
+                UniqueFutureState(UniqueFutureState&&) = delete;
+                UniqueFutureState& operator=(UniqueFutureState const&) = delete;
+                UniqueFutureState& operator=(UniqueFutureState&&) = delete;
+
+                // called at most once by the producer
+                template <typename... TArgs>
+                void SetValue(TArgs&&... args)
+                {
+                    _value.emplace(std::forward<TArgs>(args)...);
+                    Complete();
+                }
+
+                void SetException(std::exception_ptr const& exception)
+                {
+                    _exception = exception;
+                    Complete();
+                }
+
+                bool IsReady() const noexcept
+                {
+                    return (_status.load(std::memory_order_acquire) & Ready) != 0;
+                }
+
+                // the value is moved out, must only be called once the state is ready
+                T Take()
+                {
+                    if (_exception)
+                    {
+                        std::rethrow_exception(_exception);
+                    }
+
+                    if constexpr (!std::is_void_v<T>)
+                    {
+                        return std::move(*_value);
+                    }
+                }
+
+                void Wait()
+                {
+                    if (IsReady())
+                    {
+                        return;
+                    }
+
+                    Trampoline::RunPending();
+
+                    if (auto const hook = WaitHook::Current())
+                    {
+                        // the consumer is blocked, the continuation slot is therefore free for the wake function
+                        hook->Suspend([this](WaitHook::WakeFunction const& wake) {
+                            SetContinuation([wake](UniqueFutureState*) { wake(); });
+                        });
+                        return;
+                    }
+
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _status.fetch_or(HasWaiter, std::memory_order_acq_rel);
+                    _condition.wait(lock, [this]() { return IsReady(); });
+                }
+
+                // like the wait of a shared future a timed wait always blocks the thread, the wait hook cannot time out
+                template <class Rep, class Period>
+                bool WaitFor(std::chrono::duration<Rep, Period> const& timeoutDuration)
+                {
+                    if (IsReady())
+                    {
+                        return true;
+                    }
+
+                    Trampoline::RunPending();
+
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _status.fetch_or(HasWaiter, std::memory_order_acq_rel);
+                    return _condition.wait_for(lock, timeoutDuration, [this]() { return IsReady(); });
+                }
+
+                // called at most once by the consumer (besides a wait), the continuation is invoked with this state
+                // either right away, if the value is already published, or by the producer
+                template <typename F>
+                void SetContinuation(F&& continuation)
+                {
+                    SetContinuation(MakeContinuation(std::forward<F>(continuation)));
+                }
+
+                // the continuation is allocated separately, so a consumer can hand over the state only once nothing can throw anymore
+                void SetContinuation(std::unique_ptr<UniqueContinuation<T>>&& continuation)
+                {
+                    _continuation = std::move(continuation);
+                    if (_status.fetch_or(HasContinuation, std::memory_order_acq_rel) & Ready)
+                    {
+                        RunContinuation();
+                    }
+                }
+
+                template <typename F>
+                static std::unique_ptr<UniqueContinuation<T>> MakeContinuation(F&& continuation)
+                {
+                    return std::make_unique<UniqueContinuationImpl<T, std::decay_t<F>>>(std::decay_t<F>(std::forward<F>(continuation)));
+                }
+
+                // hands over the ownership, the side releasing last deletes the state
+                void Release(std::uint32_t const side) noexcept
+                {
+                    auto const other = side == PromiseReleased ? FutureReleased : PromiseReleased;
+                    if (_status.fetch_or(side, std::memory_order_acq_rel) & other)
+                    {
+                        delete this;
+                    }
+                }
+
+            private:
+                struct Empty
+                {
+                };
+
+                std::atomic<std::uint32_t> _status{ 0 };
+                std::optional<std::conditional_t<std::is_void_v<T>, Empty, T>> _value;
+                std::exception_ptr _exception;
+                std::unique_ptr<UniqueContinuation<T>> _continuation;
+
+                std::mutex _mutex;
+                std::condition_variable _condition;
+
+                void Complete()
+                {
+                    auto const previous = _status.fetch_or(Ready, std::memory_order_acq_rel);
+
+                    if (previous & HasWaiter)
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _condition.notify_all();
+                    }
+
+                    if (previous & HasContinuation)
+                    {
+                        RunContinuation();
+                    }
+                }
+
+                // the continuation may take over the consumer side and with it delete the state
+                void RunContinuation()
+                {
+                    Trampoline::Dispatch([this]() {
+                        auto continuation = std::move(_continuation);
+                        continuation->Run(this);
+                    });
+                }
+            };
+        }
+    }
+}
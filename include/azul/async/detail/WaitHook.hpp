@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+
+namespace azul
+{
+    namespace async
+    {
+        namespace detail
+        {
+            // lets an executor replace the blocking wait of a future on its threads (e.g. by suspending a fiber)
+            class WaitHook
+            {
+            public:
+                using WakeFunction = std::function<void()>;
+
+                virtual ~WaitHook() = default;
+
+                // called instead of blocking, subscribe registers the wake function on the awaited state,
+                // it is invoked (or destroyed) once the state is completed, possibly before Suspend switched away
+                virtual void Suspend(std::function<void(WakeFunction const&)> const& subscribe) = 0;
+
+                // hook of the calling thread, nullptr if waits block
+                static WaitHook*& Current() noexcept
+                {
+                    static thread_local WaitHook* current = nullptr;
+                    return current;
+                }
+            };
+        }
+    }
+}
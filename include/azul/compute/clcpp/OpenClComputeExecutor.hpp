@@ -7,11 +7,13 @@
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
+#include <azul/async/Executor.hpp>
 #include <azul/async/StaticThreadPool.hpp>
 #include <azul/compute/clcpp/OpenCl.hpp>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <stdexcept>
 #include <thread>
 #include <tuple>
 
@@ -24,10 +26,19 @@ namespace azul
             class AZUL_COMPUTE_EXPORT OpenClComputeExecutor
             {
             public:
-                explicit OpenClComputeExecutor(std::shared_ptr<async::StaticThreadPool> const& executor)
+                explicit OpenClComputeExecutor(std::shared_ptr<async::Executor> const& executor)
                     : _executor(executor)
                 {
-                    
+                    if (!_executor)
+                    {
+                        throw std::invalid_argument("The executor must not be null.");
+                    }
+                }
+
+                explicit OpenClComputeExecutor(std::shared_ptr<async::StaticThreadPool> const& executor)
+                    : OpenClComputeExecutor(async::MakeExecutor(executor))
+                {
+
                 }
 
                 azul::async::Future<void> Execute(std::function<void()> && kernel, std::tuple<std::size_t> const& globalWorkSize, std::tuple<std::size_t> const& globalWorkOffset = { 0u })
@@ -35,7 +46,7 @@ namespace azul
                     std::vector<azul::async::Future<void>> taskResults;
 
                     const auto workItems = std::get<0>(globalWorkSize);
-                    const auto workItemsPerTask = std::max<std::size_t>(workItems / _executor->ThreadCount(), 1ul);
+                    const auto workItemsPerTask = std::max<std::size_t>(workItems / _executor->Concurrency(), 1ul);
 
                     for (std::size_t i = 0; i < workItems; i += workItemsPerTask)
                     {
@@ -49,7 +60,7 @@ namespace azul
                                 kernel();
                             }
                         };
-                        taskResults.emplace_back(_executor->Execute(task));
+                        taskResults.emplace_back(async::Execute(_executor, task));
                     }
 
                     return WaitFor(taskResults);
@@ -60,7 +71,7 @@ namespace azul
                     std::vector<azul::async::Future<void>> taskResults;
 
                     const auto workItems  = std::get<0>(globalWorkSize) * std::get<1>(globalWorkSize);
-                    const auto workItemsPerTask = std::max<std::size_t>(workItems / _executor->ThreadCount(), 1ul);
+                    const auto workItemsPerTask = std::max<std::size_t>(workItems / _executor->Concurrency(), 1ul);
 
                     for (std::size_t i = 0; i < workItems; i += workItemsPerTask)
                     {
@@ -73,7 +84,7 @@ namespace azul
                                 kernel();
                             }
                         };
-                        taskResults.emplace_back(_executor->Execute(task));
+                        taskResults.emplace_back(async::Execute(_executor, task));
                     }
 
                     return WaitFor(taskResults);
@@ -84,7 +95,7 @@ namespace azul
                     std::vector<azul::async::Future<void>> taskResults;
 
                     const auto workItems  = std::get<0>(globalWorkSize) * std::get<1>(globalWorkSize) * std::get<2>(globalWorkSize);
-                    const auto workItemsPerTask = std::max<std::size_t>(workItems / _executor->ThreadCount(), 1ul);
+                    const auto workItemsPerTask = std::max<std::size_t>(workItems / _executor->Concurrency(), 1ul);
 
                     for (std::size_t i = 0; i < workItems; i += workItemsPerTask)
                     {
@@ -98,7 +109,7 @@ namespace azul
                                 kernel();
                             }
                         };
-                        taskResults.emplace_back(_executor->Execute(task));
+                        taskResults.emplace_back(async::Execute(_executor, task));
                     }
 
                     return WaitFor(taskResults);
@@ -126,7 +137,7 @@ namespace azul
                     return future;
                 }
 
-                std::shared_ptr<async::StaticThreadPool> _executor;
+                std::shared_ptr<async::Executor> _executor;
             };
         }
     }
@@ -0,0 +1,254 @@
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/Actor.hpp>
+#include <azul/async/Executor.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/detail/IntrusiveMpscQueue.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ActorTestFixture : public testing::Test
+{
+};
+
+namespace
+{
+    struct Account
+    {
+        explicit Account(int initialBalance = 0)
+            : balance(initialBalance)
+        {
+
+        }
+
+        int balance;
+        std::vector<int> history;
+    };
+
+    // refuses the given number of tasks before running them inline
+    class RefusingExecutor final : public azul::async::Executor
+    {
+    public:
+        explicit RefusingExecutor(int refusals)
+            : _refusals(refusals)
+        {
+
+        }
+
+        void Post(std::function<void()> task) override
+        {
+            if (_refusals-- > 0)
+            {
+                throw std::runtime_error("refused");
+            }
+            task();
+        }
+
+        std::size_t Concurrency() const noexcept override
+        {
+            return 1;
+        }
+
+    private:
+        int _refusals;
+    };
+}
+
+TEST_F(ActorTestFixture, Ask_MessageReturningValue_ResultForwarded)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    azul::async::Actor<Account> account(threadPool, 64u, 40);
+
+    auto balance = account.Ask([](Account& state) { return state.balance + 2; });
+
+    ASSERT_EQ(42, balance.Get());
+}
+
+TEST_F(ActorTestFixture, Ask_MessageThrows_ExceptionForwarded)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    azul::async::Actor<Account> account(threadPool);
+
+    auto result = account.Ask([](Account&) { throw std::invalid_argument(""); });
+
+    ASSERT_THROW(result.Get(), std::invalid_argument);
+}
+
+TEST_F(ActorTestFixture, Tell_ManyProducers_MessagesProcessedOneAtATime)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(4);
+    azul::async::Actor<Account> account(threadPool, 8u);
+
+    const int producers = 4;
+    const int messagesPerProducer = 1000;
+    std::atomic<int> concurrent{ 0 };
+    std::atomic<bool> overlapped{ false };
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&account, &concurrent, &overlapped]() {
+            for (int i = 0; i < messagesPerProducer; ++i)
+            {
+                account.Tell([&concurrent, &overlapped](Account& state) {
+                    if (concurrent.fetch_add(1) != 0)
+                    {
+                        overlapped = true;
+                    }
+                    ++state.balance;
+                    concurrent.fetch_sub(1);
+                });
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(producers * messagesPerProducer, account.Ask([](Account& state) { return state.balance; }).Get());
+    ASSERT_FALSE(overlapped.load());
+}
+
+TEST_F(ActorTestFixture, Tell_SingleProducer_ProcessedInSubmissionOrder)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    azul::async::Actor<Account> account(threadPool, 4u);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        account.Tell([i](Account& state) { state.history.push_back(i); });
+    }
+
+    auto history = account.Ask([](Account& state) { return state.history; }).Get();
+
+    ASSERT_EQ(100u, history.size());
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(i, history[i]);
+    }
+}
+
+TEST_F(ActorTestFixture, Tell_MessageThrows_ActorKeepsProcessing)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    azul::async::Actor<Account> account(threadPool);
+
+    account.Tell([](Account&) { throw std::runtime_error(""); });
+    account.Tell([](Account& state) { state.balance = 7; });
+
+    ASSERT_EQ(7, account.Ask([](Account& state) { return state.balance; }).Get());
+}
+
+TEST_F(ActorTestFixture, Ask_TypeErasedExecutor_ResultForwarded)
+{
+    auto executor = azul::async::MakeExecutor(std::make_shared<azul::async::StaticThreadPool>(1));
+    azul::async::Actor<Account, azul::async::Executor> account(executor, 16u, 5);
+
+    ASSERT_EQ(5, account.Ask([](Account& state) { return state.balance; }).Get());
+}
+
+TEST_F(ActorTestFixture, Ask_ExecutorRefusesActor_FailedAndActorNotStuck)
+{
+    auto executor = std::make_shared<RefusingExecutor>(1);
+    azul::async::Actor<Account, RefusingExecutor> account(executor, 64u, 40);
+
+    auto refused = account.Ask([](Account& state) { return state.balance; });
+    ASSERT_THROW(refused.Get(), std::runtime_error);
+
+    account.Tell([](Account& state) { state.balance += 2; });
+    ASSERT_EQ(42, account.Ask([](Account& state) { return state.balance; }).Get());
+}
+
+TEST_F(ActorTestFixture, Ask_BoundedPoolRejectsDrain_FailedAndActorNotStuck)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::Reject;
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1, options);
+    azul::async::Actor<Account> account(threadPool, 64u, 40);
+
+    azul::async::Promise<void> gate;
+    auto running = std::make_shared<azul::async::Promise<void>>();
+    auto blocker = threadPool->Execute([&gate, running]() { running->SetValue(); gate.GetFuture().Wait(); });
+    running->GetFuture().Wait();
+    auto queued = threadPool->Execute([]() {});
+
+    auto refused = account.Ask([](Account& state) { return state.balance; });
+    try
+    {
+        refused.Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::QueueFull, error.ErrorCode());
+    }
+
+    gate.SetValue();
+    blocker.Wait();
+    queued.Wait();
+
+    account.Tell([](Account& state) { state.balance += 2; });
+    ASSERT_EQ(42, account.Ask([](Account& state) { return state.balance; }).Get());
+}
+
+TEST_F(ActorTestFixture, Actor_ManyIdleActors_AllRespond)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+
+    const int numberOfActors = 100000;
+    std::vector<azul::async::Actor<int>> actors;
+    actors.reserve(numberOfActors);
+    for (int i = 0; i < numberOfActors; ++i)
+    {
+        actors.emplace_back(threadPool, 64u, i);
+    }
+
+    std::vector<azul::async::Future<int>> replies;
+    for (int i = 0; i < numberOfActors; i += 1000)
+    {
+        replies.emplace_back(actors[i].Ask([](int& state) { return state; }));
+    }
+
+    for (std::size_t i = 0; i < replies.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<int>(i * 1000), replies[i].Get());
+    }
+}
+
+TEST_F(ActorTestFixture, IntrusiveMpscQueue_PushPop_FifoOrder)
+{
+    struct Node : azul::async::detail::IntrusiveMpscNode
+    {
+        explicit Node(int v)
+            : value(v)
+        {
+
+        }
+
+        int value;
+    };
+
+    azul::async::detail::IntrusiveMpscQueue<Node> queue;
+    ASSERT_EQ(nullptr, queue.TryPop());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        queue.Push(new Node(i));
+    }
+
+    for (int i = 0; i < 3; ++i)
+    {
+        auto node = std::unique_ptr<Node>(queue.TryPop());
+        ASSERT_NE(nullptr, node);
+        ASSERT_EQ(i, node->value);
+    }
+    ASSERT_EQ(nullptr, queue.TryPop());
+
+    // leftover nodes are deleted by the queue
+    queue.Push(new Node(3));
+}
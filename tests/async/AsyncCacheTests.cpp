@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <gmock/gmock.h>
+#include <azul/async/AsyncCache.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class AsyncCacheTestFixture : public testing::Test
+{
+};
+
+TEST_F(AsyncCacheTestFixture, GetOrCompute_Miss_LoaderResultCached)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    azul::async::AsyncCache<int, std::string> cache(threadPool);
+    std::atomic<int> loads{ 0 };
+
+    ASSERT_EQ("1", cache.GetOrCompute(1, [&loads]() { ++loads; return std::string("1"); }).Get());
+    ASSERT_EQ("1", cache.GetOrCompute(1, [&loads]() { ++loads; return std::string("other"); }).Get());
+
+    ASSERT_EQ(1, loads.load());
+    ASSERT_EQ("1", cache.TryGet(1).value());
+    ASSERT_EQ(1u, cache.Statistics().misses);
+}
+
+TEST_F(AsyncCacheTestFixture, GetOrCompute_ConcurrentMisses_SingleComputation)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(4);
+    azul::async::AsyncCache<int, int> cache(threadPool);
+    azul::async::Promise<void> release;
+    auto released = release.GetFuture();
+    std::atomic<int> loads{ 0 };
+
+    std::vector<azul::async::Future<int>> futures;
+    for (int i = 0; i < 100; ++i)
+    {
+        futures.emplace_back(cache.GetOrCompute(7, [&loads, released]() { ++loads; released.Wait(); return 49; }));
+    }
+    release.SetValue();
+
+    std::for_each(futures.begin(), futures.end(), [](auto f) { ASSERT_EQ(49, f.Get()); });
+    ASSERT_EQ(1, loads.load());
+    ASSERT_EQ(99u, cache.Statistics().hits);
+}
+
+TEST_F(AsyncCacheTestFixture, GetOrCompute_LoaderThrows_ErrorNotCached)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    azul::async::AsyncCache<int, int> cache(threadPool);
+
+    auto failed = cache.GetOrCompute(1, []() -> int { throw std::runtime_error("backend"); });
+    ASSERT_THROW(failed.Get(), std::runtime_error);
+
+    ASSERT_EQ(0u, cache.Size());
+    ASSERT_EQ(2, cache.GetOrCompute(1, []() { return 2; }).Get());
+}
+
+TEST_F(AsyncCacheTestFixture, GetOrCompute_LoaderDroppedByBoundedPool_ErrorNotCached)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::DropOldest;
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1, options);
+    azul::async::AsyncCache<int, int> cache(threadPool);
+
+    azul::async::Promise<void> gate;
+    auto running = std::make_shared<azul::async::Promise<void>>();
+    auto blocker = threadPool->Execute([&gate, running]() { running->SetValue(); gate.GetFuture().Wait(); });
+    running->GetFuture().Wait();
+
+    auto dropped = cache.GetOrCompute(1, []() { return 1; });
+    auto displacing = threadPool->Execute([]() {});
+    try
+    {
+        dropped.Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::BrokenPromise, error.ErrorCode());
+    }
+    ASSERT_EQ(0u, cache.Size());
+
+    gate.SetValue();
+    ASSERT_EQ(2, cache.GetOrCompute(1, []() { return 2; }).Get());
+}
+
+TEST_F(AsyncCacheTestFixture, GetOrCompute_EntryExpired_RecomputedAfterTimeToLive)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    azul::async::AsyncCacheOptions options;
+    options.timeToLive = std::chrono::milliseconds(20);
+    azul::async::AsyncCache<int, int> cache(threadPool, options);
+
+    cache.GetOrCompute(1, []() { return 1; }).Get();
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+
+    ASSERT_FALSE(cache.TryGet(1).has_value());
+    ASSERT_EQ(2, cache.GetOrCompute(1, []() { return 2; }).Get());
+}
+
+TEST_F(AsyncCacheTestFixture, GetOrCompute_CapacityExceeded_UnreferencedEntryEvicted)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    azul::async::AsyncCacheOptions options;
+    options.capacity = 2;
+    options.shards = 1;
+    azul::async::AsyncCache<int, int> cache(threadPool, options);
+
+    cache.GetOrCompute(1, []() { return 1; }).Get();
+    cache.GetOrCompute(2, []() { return 2; }).Get();
+    // gives the first entry a second chance
+    cache.TryGet(1);
+    cache.GetOrCompute(3, []() { return 3; }).Get();
+
+    ASSERT_EQ(2u, cache.Size());
+    ASSERT_TRUE(cache.TryGet(1).has_value());
+    ASSERT_FALSE(cache.TryGet(2).has_value());
+    ASSERT_TRUE(cache.TryGet(3).has_value());
+    ASSERT_EQ(1u, cache.Statistics().evictions);
+}
+
+TEST_F(AsyncCacheTestFixture, Invalidate_EntryCached_RemovedFromCache)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    azul::async::AsyncCache<int, int> cache(threadPool);
+
+    cache.GetOrCompute(1, []() { return 1; }).Get();
+    cache.Invalidate(1);
+
+    ASSERT_FALSE(cache.TryGet(1).has_value());
+    ASSERT_EQ(0u, cache.Size());
+}
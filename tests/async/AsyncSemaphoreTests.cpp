@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/AsyncSemaphore.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <vector>
+
+class AsyncSemaphoreTestFixture : public testing::Test
+{
+};
+
+TEST_F(AsyncSemaphoreTestFixture, Acquire_PermitsAvailable_ReadyFuture)
+{
+    azul::async::AsyncSemaphore semaphore(2);
+
+    ASSERT_TRUE(semaphore.Acquire().IsReady());
+    ASSERT_TRUE(semaphore.Acquire().IsReady());
+    ASSERT_EQ(0, semaphore.Available());
+}
+
+TEST_F(AsyncSemaphoreTestFixture, Acquire_NoPermitsAvailable_ReadyAfterRelease)
+{
+    azul::async::AsyncSemaphore semaphore(1);
+    semaphore.Acquire().Get();
+
+    auto first = semaphore.Acquire();
+    auto second = semaphore.Acquire();
+    ASSERT_FALSE(first.IsReady());
+    ASSERT_FALSE(semaphore.TryAcquire());
+
+    semaphore.Release();
+    ASSERT_TRUE(first.IsReady());
+    ASSERT_FALSE(second.IsReady());
+
+    semaphore.Release();
+    ASSERT_TRUE(second.IsReady());
+}
+
+TEST_F(AsyncSemaphoreTestFixture, Release_MultiplePermits_WaitersAndPermitsBalanced)
+{
+    azul::async::AsyncSemaphore semaphore(0);
+
+    auto first = semaphore.Acquire();
+    semaphore.Release(3);
+
+    ASSERT_TRUE(first.IsReady());
+    ASSERT_EQ(2, semaphore.Available());
+    ASSERT_TRUE(semaphore.TryAcquire());
+}
+
+TEST_F(AsyncSemaphoreTestFixture, Acquire_PendingFutureDropped_PermitPassedOnToNextWaiter)
+{
+    azul::async::AsyncSemaphore semaphore(0);
+
+    semaphore.Acquire();
+    auto waiting = semaphore.Acquire();
+
+    semaphore.Release();
+    ASSERT_TRUE(waiting.IsReady());
+    ASSERT_EQ(0, semaphore.Available());
+}
+
+TEST_F(AsyncSemaphoreTestFixture, Acquire_PendingFutureDroppedNoOtherWaiter_PermitAvailableAgain)
+{
+    azul::async::AsyncSemaphore semaphore(0);
+
+    semaphore.Acquire();
+
+    semaphore.Release();
+    ASSERT_EQ(1, semaphore.Available());
+    ASSERT_TRUE(semaphore.TryAcquire());
+}
+
+TEST_F(AsyncSemaphoreTestFixture, Acquire_SemaphoreDestroyedWithWaiters_BrokenPromise)
+{
+    azul::async::Future<void> waiting;
+    {
+        azul::async::AsyncSemaphore semaphore(0);
+        waiting = semaphore.Acquire();
+    }
+
+    ASSERT_THROW(waiting.Get(), azul::async::FutureError);
+}
+
+TEST_F(AsyncSemaphoreTestFixture, Lock_TasksOnPool_CriticalSectionsDoNotOverlap)
+{
+    azul::async::AsyncMutex mutex;
+    std::atomic<int> inside{ 0 };
+    std::atomic<int> maximum{ 0 };
+    int counter = 0;
+
+    {
+        azul::async::StaticThreadPool threadPool(4);
+        std::vector<azul::async::Future<azul::async::Future<void>>> futures;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            futures.emplace_back(threadPool.Execute([&]() {
+                return mutex.Lock().Then([&](azul::async::Future<void>) {
+                    auto const current = ++inside;
+                    maximum = std::max(maximum.load(), current);
+                    ++counter;
+                    --inside;
+                    mutex.Unlock();
+                });
+            }));
+        }
+        std::for_each(futures.begin(), futures.end(), [](auto f) { f.Get().Get(); });
+    }
+
+    ASSERT_EQ(1000, counter);
+    ASSERT_EQ(1, maximum.load());
+}
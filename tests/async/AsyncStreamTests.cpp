@@ -0,0 +1,322 @@
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/AsyncStream.hpp>
+#include <azul/async/Channel.hpp>
+#include <azul/async/Executor.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class AsyncStreamTestFixture : public testing::Test
+{
+};
+
+namespace
+{
+    template <typename T>
+    std::vector<T> Collect(azul::async::AsyncStream<T> stream)
+    {
+        std::vector<T> values;
+        while (auto value = stream.Next().Get())
+        {
+            values.push_back(*value);
+        }
+        return values;
+    }
+}
+
+TEST_F(AsyncStreamTestFixture, Next_FromValues_ValuesFollowedByEnd)
+{
+    auto stream = azul::async::AsyncStream<int>::FromValues({ 1, 2 });
+
+    ASSERT_EQ(1, stream.Next().Get().value());
+    ASSERT_EQ(2, stream.Next().Get().value());
+    ASSERT_FALSE(stream.Next().Get().has_value());
+    ASSERT_FALSE(stream.Next().Get().has_value());
+}
+
+TEST_F(AsyncStreamTestFixture, Next_GeneratorNotPulled_NothingProduced)
+{
+    std::atomic<int> produced{ 0 };
+    auto stream = azul::async::AsyncStream<int>::FromGenerator([&produced]() {
+        return std::optional<int>(produced++);
+    }).Map([](int value) { return value * 2; }).Filter([](int) { return true; });
+
+    ASSERT_EQ(0, produced.load());
+
+    ASSERT_EQ(0, stream.Next().Get().value());
+    ASSERT_EQ(2, stream.Next().Get().value());
+    ASSERT_EQ(2, produced.load());
+}
+
+TEST_F(AsyncStreamTestFixture, Next_GeneratorThrows_ExceptionForwarded)
+{
+    auto stream = azul::async::AsyncStream<int>::FromGenerator([]() -> std::optional<int> {
+        throw std::runtime_error("");
+    });
+
+    ASSERT_THROW(stream.Next().Get(), std::runtime_error);
+}
+
+TEST_F(AsyncStreamTestFixture, Next_AsynchronousGenerator_ValuesForwarded)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+
+    int next = 0;
+    auto stream = azul::async::AsyncStream<int>::FromGenerator([pool = threadPool.get(), &next]() {
+        return pool->Execute([&next]() {
+            return next < 3 ? std::optional<int>(next++) : std::optional<int>();
+        });
+    });
+
+    ASSERT_THAT(Collect(stream), testing::ElementsAre(0, 1, 2));
+}
+
+TEST_F(AsyncStreamTestFixture, Map_WithExecutor_CallableRunsOnExecutor)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    auto executor = azul::async::MakeExecutor(threadPool);
+    auto const caller = std::this_thread::get_id();
+
+    std::atomic<bool> ranOnCaller{ false };
+    auto stream = azul::async::AsyncStream<int>::FromValues({ 1, 2, 3 }).Map([caller, &ranOnCaller](int value) {
+        if (std::this_thread::get_id() == caller)
+        {
+            ranOnCaller = true;
+        }
+        return std::to_string(value);
+    }, executor);
+
+    ASSERT_THAT(Collect(stream), testing::ElementsAre("1", "2", "3"));
+    ASSERT_FALSE(ranOnCaller.load());
+}
+
+TEST_F(AsyncStreamTestFixture, Map_StreamAndExecutorDestroyedWhileValuePending_BrokenPromise)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    auto executor = azul::async::MakeExecutor(threadPool);
+    azul::async::Promise<std::optional<int>> value;
+
+    azul::async::Future<std::optional<std::string>> next;
+    {
+        auto stream = azul::async::AsyncStream<int>::FromGenerator([&value]() {
+            return value.GetFuture();
+        }).Map([](int number) { return std::to_string(number); }, executor);
+        executor.reset();
+
+        next = stream.Next();
+    }
+
+    value.SetValue(std::optional<int>(1));
+    try
+    {
+        next.Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::BrokenPromise, error.ErrorCode());
+    }
+}
+
+TEST_F(AsyncStreamTestFixture, Map_CallableThrows_ExceptionForwarded)
+{
+    auto stream = azul::async::AsyncStream<int>::FromValues({ 1 }).Map([](int) -> int {
+        throw std::invalid_argument("");
+    });
+
+    ASSERT_THROW(stream.Next().Get(), std::invalid_argument);
+}
+
+TEST_F(AsyncStreamTestFixture, Filter_LongRunOfRejectedValues_NoRecursion)
+{
+    std::vector<int> values(1000000);
+    std::iota(values.begin(), values.end(), 0);
+
+    auto stream = azul::async::AsyncStream<int>::FromValues(std::move(values)).Filter([](int value) {
+        return value % 500000 == 499999;
+    });
+
+    ASSERT_THAT(Collect(stream), testing::ElementsAre(499999, 999999));
+}
+
+TEST_F(AsyncStreamTestFixture, Filter_WithExecutor_ValuesFiltered)
+{
+    auto executor = azul::async::MakeExecutor(std::make_shared<azul::async::StaticThreadPool>(2));
+
+    auto stream = azul::async::AsyncStream<int>::FromValues({ 1, 2, 3, 4, 5, 6 }).Filter([](int value) {
+        return value % 2 == 0;
+    }, executor);
+
+    ASSERT_THAT(Collect(stream), testing::ElementsAre(2, 4, 6));
+}
+
+TEST_F(AsyncStreamTestFixture, Filter_StreamAndExecutorDestroyedWhileValuePending_BrokenPromise)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    auto executor = azul::async::MakeExecutor(threadPool);
+    azul::async::Promise<std::optional<int>> value;
+
+    azul::async::Future<std::optional<int>> next;
+    {
+        auto stream = azul::async::AsyncStream<int>::FromGenerator([&value]() {
+            return value.GetFuture();
+        }).Filter([](int) { return true; }, executor);
+        executor.reset();
+
+        next = stream.Next();
+    }
+
+    value.SetValue(std::optional<int>(1));
+    try
+    {
+        next.Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::BrokenPromise, error.ErrorCode());
+    }
+}
+
+TEST_F(AsyncStreamTestFixture, Batch_ValuesLeft_LastBatchSmaller)
+{
+    auto stream = azul::async::AsyncStream<int>::FromValues({ 1, 2, 3, 4, 5 }).Batch(2);
+
+    ASSERT_THAT(stream.Next().Get().value(), testing::ElementsAre(1, 2));
+    ASSERT_THAT(stream.Next().Get().value(), testing::ElementsAre(3, 4));
+    ASSERT_THAT(stream.Next().Get().value(), testing::ElementsAre(5));
+    ASSERT_FALSE(stream.Next().Get().has_value());
+}
+
+TEST_F(AsyncStreamTestFixture, Buffer_Consumed_ProducerRunsAheadAtMostCapacity)
+{
+    std::atomic<int> produced{ 0 };
+    auto stream = azul::async::AsyncStream<int>::FromGenerator([&produced]() {
+        return std::optional<int>(produced++);
+    }).Buffer(4);
+
+    ASSERT_EQ(0, produced.load());
+
+    ASSERT_EQ(0, stream.Next().Get().value());
+    ASSERT_EQ(5, produced.load());
+
+    ASSERT_EQ(1, stream.Next().Get().value());
+    ASSERT_EQ(6, produced.load());
+}
+
+TEST_F(AsyncStreamTestFixture, Buffer_SlowProducer_AllValuesInOrder)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+
+    std::atomic<int> next{ 0 };
+    auto stream = azul::async::AsyncStream<int>::FromGenerator([pool = threadPool.get(), &next]() {
+        return pool->Execute([&next]() {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            auto const value = next++;
+            return value < 100 ? std::optional<int>(value) : std::optional<int>();
+        });
+    }).Buffer(8);
+
+    auto values = Collect(stream);
+
+    std::vector<int> expected(100);
+    std::iota(expected.begin(), expected.end(), 0);
+    ASSERT_EQ(expected, values);
+}
+
+TEST_F(AsyncStreamTestFixture, Merge_SeveralStreams_EveryValueOnce)
+{
+    auto executor = azul::async::MakeExecutor(std::make_shared<azul::async::StaticThreadPool>(2));
+
+    std::vector<azul::async::AsyncStream<int>> streams;
+    for (int s = 0; s < 4; ++s)
+    {
+        std::vector<int> values;
+        for (int i = 0; i < 250; ++i)
+        {
+            values.push_back(s * 250 + i);
+        }
+        streams.push_back(azul::async::AsyncStream<int>::FromValues(std::move(values)).Map([](int value) { return value; }, executor));
+    }
+
+    auto values = Collect(azul::async::AsyncStream<int>::Merge(streams));
+    std::sort(values.begin(), values.end());
+
+    std::vector<int> expected(1000);
+    std::iota(expected.begin(), expected.end(), 0);
+    ASSERT_EQ(expected, values);
+}
+
+TEST_F(AsyncStreamTestFixture, Merge_OneStreamFails_OtherStreamContinues)
+{
+    auto failing = azul::async::AsyncStream<int>::FromGenerator([]() -> std::optional<int> {
+        throw std::runtime_error("");
+    });
+    auto merged = azul::async::AsyncStream<int>::FromValues({ 1, 2 }).Merge(failing);
+
+    std::vector<int> values;
+    int errors = 0;
+    for (;;)
+    {
+        try
+        {
+            auto value = merged.Next().Get();
+            if (!value)
+            {
+                break;
+            }
+            values.push_back(*value);
+        }
+        catch (std::runtime_error const&)
+        {
+            ++errors;
+        }
+    }
+
+    ASSERT_EQ(1, errors);
+    ASSERT_THAT(values, testing::ElementsAre(1, 2));
+}
+
+TEST_F(AsyncStreamTestFixture, FromChannel_ChannelFull_SenderWaitsForConsumer)
+{
+    azul::async::Channel<int> channel(1);
+    auto stream = azul::async::AsyncStream<int>::FromChannel(channel);
+
+    channel.Send(1).Get();
+    auto sent = channel.Send(2);
+    ASSERT_FALSE(sent.IsReady());
+
+    ASSERT_EQ(1, stream.Next().Get().value());
+    ASSERT_TRUE(sent.IsReady());
+
+    channel.Close();
+    ASSERT_EQ(2, stream.Next().Get().value());
+    ASSERT_FALSE(stream.Next().Get().has_value());
+}
+
+TEST_F(AsyncStreamTestFixture, ForEach_WithExecutor_EveryValueVisited)
+{
+    auto executor = azul::async::MakeExecutor(std::make_shared<azul::async::StaticThreadPool>(2));
+
+    int sum = 0;
+    auto done = azul::async::AsyncStream<int>::FromValues({ 1, 2, 3, 4 }).ForEach([&sum](int value) {
+        sum += value;
+    }, executor);
+
+    done.Get();
+    ASSERT_EQ(10, sum);
+}
+
+TEST_F(AsyncStreamTestFixture, ForEach_CallableThrows_ExceptionForwarded)
+{
+    auto done = azul::async::AsyncStream<int>::FromValues({ 1, 2 }).ForEach([](int) {
+        throw std::invalid_argument("");
+    });
+
+    ASSERT_THROW(done.Get(), std::invalid_argument);
+}
@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <gmock/gmock.h>
+#include <azul/async/Barrier.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <stdexcept>
+#include <vector>
+
+class BarrierTestFixture : public testing::Test
+{
+};
+
+TEST_F(BarrierTestFixture, ArriveAndWait_AllParticipantsArrived_PhaseCompleted)
+{
+    azul::async::Barrier barrier(2);
+
+    auto first = barrier.ArriveAndWait();
+    ASSERT_FALSE(first.IsReady());
+
+    auto second = barrier.ArriveAndWait();
+    ASSERT_TRUE(first.IsReady());
+    ASSERT_TRUE(second.IsReady());
+    ASSERT_EQ(1u, barrier.Generation());
+}
+
+TEST_F(BarrierTestFixture, ArriveAndWait_NextPhase_NotCompletedByPreviousPhase)
+{
+    azul::async::Barrier barrier(2);
+
+    barrier.ArriveAndWait();
+    barrier.ArriveAndWait();
+    auto next = barrier.ArriveAndWait();
+
+    ASSERT_FALSE(next.IsReady());
+    barrier.ArriveAndWait();
+    ASSERT_TRUE(next.IsReady());
+    ASSERT_EQ(2u, barrier.Generation());
+}
+
+TEST_F(BarrierTestFixture, Constructor_NoParticipants_ThrowsInvalidArgument)
+{
+    ASSERT_THROW(azul::async::Barrier(0), std::invalid_argument);
+}
+
+TEST_F(BarrierTestFixture, ArriveAndWait_TasksOnSingleThread_NoThreadBlocked)
+{
+    // a single worker could not complete the phase if arriving blocked it
+    azul::async::StaticThreadPool threadPool(1);
+    azul::async::Barrier barrier(8);
+    std::vector<azul::async::Future<azul::async::Future<void>>> futures;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        futures.emplace_back(threadPool.Execute([&barrier]() { return barrier.ArriveAndWait(); }));
+    }
+
+    std::for_each(futures.begin(), futures.end(), [](auto f) { f.Get().Get(); });
+    ASSERT_EQ(1u, barrier.Generation());
+}
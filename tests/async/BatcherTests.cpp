@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <gmock/gmock.h>
+#include <azul/async/Batcher.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/TimerService.hpp>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+class BatcherTestFixture : public testing::Test
+{
+protected:
+    std::shared_ptr<azul::async::StaticThreadPool> _threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    std::shared_ptr<azul::async::TimerService> _timers = std::make_shared<azul::async::TimerService>(_threadPool);
+};
+
+TEST_F(BatcherTestFixture, Submit_BatchFull_DispatchedAsOneBatch)
+{
+    std::atomic<int> calls{ 0 };
+    azul::async::BatcherOptions options;
+    options.maxBatchSize = 4;
+    options.maxDelay = std::chrono::seconds(60);
+
+    azul::async::Batcher<int, int> batcher(_threadPool, _timers, [&calls](std::vector<int> const& requests) {
+        ++calls;
+        std::vector<int> responses;
+        std::transform(requests.begin(), requests.end(), std::back_inserter(responses), [](int r) { return r * r; });
+        return responses;
+    }, options);
+
+    std::vector<azul::async::Future<int>> futures;
+    for (int i = 0; i < 4; ++i)
+    {
+        futures.emplace_back(batcher.Submit(i));
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(i * i, futures[i].Get());
+    }
+    ASSERT_EQ(1, calls.load());
+
+    auto const statistics = batcher.Statistics();
+    ASSERT_EQ(1u, statistics.batchSize.count);
+    ASSERT_EQ(4u, statistics.batchSize.max);
+    ASSERT_EQ(4u, statistics.queueDelay.count);
+}
+
+TEST_F(BatcherTestFixture, Submit_BatchNotFull_DispatchedAfterDelay)
+{
+    azul::async::BatcherOptions options;
+    options.maxBatchSize = 100;
+    options.maxDelay = std::chrono::milliseconds(5);
+
+    azul::async::Batcher<int, int> batcher(_threadPool, _timers, [](std::vector<int> const& requests) { return requests; }, options);
+
+    auto first = batcher.Submit(1);
+    auto second = batcher.Submit(2);
+
+    ASSERT_EQ(1, first.Get());
+    ASSERT_EQ(2, second.Get());
+    ASSERT_EQ(2u, batcher.Statistics().batchSize.max);
+}
+
+TEST_F(BatcherTestFixture, Submit_BatchFunctionThrows_AllRequestsFail)
+{
+    azul::async::BatcherOptions options;
+    options.maxBatchSize = 2;
+
+    azul::async::Batcher<int, int> batcher(_threadPool, _timers, [](std::vector<int> const&) -> std::vector<int> {
+        throw std::runtime_error("backend");
+    }, options);
+
+    auto first = batcher.Submit(1);
+    auto second = batcher.Submit(2);
+
+    ASSERT_THROW(first.Get(), std::runtime_error);
+    ASSERT_THROW(second.Get(), std::runtime_error);
+}
+
+TEST_F(BatcherTestFixture, Submit_WrongNumberOfResponses_AllRequestsFail)
+{
+    azul::async::BatcherOptions options;
+    options.maxBatchSize = 2;
+
+    azul::async::Batcher<int, int> batcher(_threadPool, _timers, [](std::vector<int> const&) { return std::vector<int>{ 1 }; }, options);
+
+    auto first = batcher.Submit(1);
+    auto second = batcher.Submit(2);
+
+    ASSERT_THROW(first.Get(), std::logic_error);
+    ASSERT_THROW(second.Get(), std::logic_error);
+}
+
+TEST_F(BatcherTestFixture, Destructor_RequestsPending_BatchDispatched)
+{
+    azul::async::Future<int> future;
+    {
+        azul::async::BatcherOptions options;
+        options.maxDelay = std::chrono::seconds(60);
+        azul::async::Batcher<int, int> batcher(_threadPool, _timers, [](std::vector<int> const& requests) { return requests; }, options);
+        future = batcher.Submit(5);
+    }
+
+    ASSERT_EQ(5, future.Get());
+}
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/Channel.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+class ChannelTestFixture : public testing::Test
+{
+};
+
+TEST_F(ChannelTestFixture, TrySend_SpaceAvailable_ValuesReceivedInOrder)
+{
+    azul::async::Channel<int> channel(2);
+
+    ASSERT_TRUE(channel.TrySend(1));
+    ASSERT_TRUE(channel.TrySend(2));
+    ASSERT_EQ(2u, channel.Size());
+
+    ASSERT_EQ(1, channel.TryReceive().value());
+    ASSERT_EQ(2, channel.TryReceive().value());
+    ASSERT_FALSE(channel.TryReceive().has_value());
+}
+
+TEST_F(ChannelTestFixture, TrySend_ChannelFull_ReturnsFalse)
+{
+    azul::async::Channel<int> channel(1);
+
+    ASSERT_TRUE(channel.TrySend(1));
+    ASSERT_FALSE(channel.TrySend(2));
+    ASSERT_EQ(1u, channel.Size());
+}
+
+TEST_F(ChannelTestFixture, Receive_ChannelEmpty_CompletedBySend)
+{
+    azul::async::Channel<int> channel(1);
+
+    auto received = channel.Receive();
+    ASSERT_FALSE(received.IsReady());
+
+    auto sent = channel.Send(42);
+
+    ASSERT_TRUE(sent.IsReady());
+    ASSERT_EQ(42, received.Get());
+    ASSERT_EQ(0u, channel.Size());
+}
+
+TEST_F(ChannelTestFixture, Receive_FutureDropped_ValueGoesToNextReceiver)
+{
+    azul::async::Channel<int> channel(1);
+
+    channel.Receive();
+    auto received = channel.Receive();
+
+    channel.Send(42).Get();
+
+    ASSERT_EQ(42, received.Get());
+    ASSERT_EQ(0u, channel.Size());
+}
+
+TEST_F(ChannelTestFixture, Receive_FutureDroppedAfterContinuationAttached_ValueDeliveredToContinuation)
+{
+    azul::async::Channel<int> channel(1);
+
+    int value = 0;
+    channel.Receive().Then([&value](azul::async::Future<int> received) { value = received.Get(); });
+
+    channel.Send(42).Get();
+
+    ASSERT_EQ(42, value);
+    ASSERT_FALSE(channel.TryReceive().has_value());
+}
+
+TEST_F(ChannelTestFixture, Send_ChannelFull_CompletedByReceive)
+{
+    azul::async::Channel<int> channel(1);
+
+    channel.Send(1).Get();
+    auto sent = channel.Send(2);
+    ASSERT_FALSE(sent.IsReady());
+
+    ASSERT_EQ(1, channel.Receive().Get());
+    ASSERT_TRUE(sent.IsReady());
+    ASSERT_EQ(2, channel.TryReceive().value());
+}
+
+TEST_F(ChannelTestFixture, Send_Unbuffered_WaitsForReceiver)
+{
+    azul::async::Channel<int> channel(0);
+
+    ASSERT_FALSE(channel.TrySend(1));
+    auto sent = channel.Send(1);
+    ASSERT_FALSE(sent.IsReady());
+
+    ASSERT_EQ(1, channel.TryReceive().value());
+    ASSERT_TRUE(sent.IsReady());
+}
+
+TEST_F(ChannelTestFixture, Close_WaitersPending_WaitersFailedAndBufferDrained)
+{
+    azul::async::Channel<int> channel(1);
+    azul::async::Channel<int> empty(1);
+
+    channel.Send(1).Get();
+    auto sent = channel.Send(2);
+    auto received = empty.Receive();
+
+    channel.Close();
+    empty.Close();
+
+    ASSERT_TRUE(channel.Closed());
+    ASSERT_THROW(sent.Get(), azul::async::FutureError);
+    ASSERT_THROW(received.Get(), azul::async::FutureError);
+    ASSERT_FALSE(channel.TrySend(3));
+    ASSERT_EQ(1, channel.Receive().Get());
+    try
+    {
+        channel.Receive().Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::ChannelClosed, error.ErrorCode());
+    }
+}
+
+TEST_F(ChannelTestFixture, Receive_WithExecutor_ReceiverResumedOnPool)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    azul::async::Channel<int> channel(1, threadPool);
+
+    auto resumedOn = channel.Receive().Then([](azul::async::Future<int>) { return std::this_thread::get_id(); });
+    channel.Send(1);
+
+    ASSERT_NE(std::this_thread::get_id(), resumedOn.Get());
+}
+
+TEST_F(ChannelTestFixture, SendReceive_MultipleProducersAndConsumers_AllValuesReceivedOnce)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    azul::async::Channel<int> channel(8, threadPool);
+
+    const int producers = 4;
+    const int valuesPerProducer = 500;
+    std::vector<std::thread> threads;
+    std::vector<long> sums(producers, 0);
+
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&channel, p]() {
+            for (int i = 1; i <= valuesPerProducer; ++i)
+            {
+                channel.Send(p * valuesPerProducer + i).Wait();
+            }
+        });
+        threads.emplace_back([&channel, &sums, p]() {
+            for (int i = 0; i < valuesPerProducer; ++i)
+            {
+                sums[p] += channel.Receive().Get();
+            }
+        });
+    }
+    std::for_each(threads.begin(), threads.end(), [](auto& t) { t.join(); });
+
+    const long n = producers * valuesPerProducer;
+    ASSERT_EQ(n * (n + 1) / 2, std::accumulate(sums.begin(), sums.end(), 0L));
+    ASSERT_EQ(0u, channel.Size());
+}
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/Executor.hpp>
+#include <azul/async/SpinningExecutor.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/Strand.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class ExecutorTestFixture : public testing::Test
+{
+};
+
+TEST_F(ExecutorTestFixture, InlineExecutor_Post_RunsOnCallingThread)
+{
+    azul::async::InlineExecutor executor;
+    std::thread::id executedOn;
+
+    executor.Post([&executedOn]() { executedOn = std::this_thread::get_id(); });
+
+    ASSERT_EQ(std::this_thread::get_id(), executedOn);
+    ASSERT_EQ(1u, executor.Concurrency());
+}
+
+TEST_F(ExecutorTestFixture, MakeExecutor_ThreadPool_ConcurrencyIsThreadCount)
+{
+    auto executor = azul::async::MakeExecutor(std::make_shared<azul::async::StaticThreadPool>(3));
+
+    ASSERT_EQ(3u, executor->Concurrency());
+}
+
+TEST_F(ExecutorTestFixture, MakeExecutor_Strand_ConcurrencyIsOne)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(3);
+    auto executor = azul::async::MakeExecutor(std::make_shared<azul::async::Strand<azul::async::StaticThreadPool>>(threadPool));
+
+    ASSERT_EQ(1u, executor->Concurrency());
+}
+
+TEST_F(ExecutorTestFixture, MakeExecutor_AlreadyAnExecutor_ReturnedUnchanged)
+{
+    std::shared_ptr<azul::async::InlineExecutor> inlineExecutor = std::make_shared<azul::async::InlineExecutor>();
+
+    ASSERT_EQ(inlineExecutor.get(), azul::async::MakeExecutor(inlineExecutor).get());
+}
+
+TEST_F(ExecutorTestFixture, Execute_DifferentExecutors_SameCallSiteProducesResult)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    std::vector<std::shared_ptr<azul::async::Executor>> executors {
+        std::make_shared<azul::async::InlineExecutor>(),
+        azul::async::MakeExecutor(threadPool),
+        azul::async::MakeExecutor(std::make_shared<azul::async::Strand<azul::async::StaticThreadPool>>(threadPool)),
+        azul::async::MakeExecutor(std::make_shared<azul::async::SpinningExecutor>(1))
+    };
+
+    for (auto const& executor : executors)
+    {
+        auto result = azul::async::Execute(executor, []() { return 42; });
+        ASSERT_EQ(42, result.Get());
+    }
+}
+
+TEST_F(ExecutorTestFixture, Execute_CallableThrows_ExceptionForwarded)
+{
+    auto executor = azul::async::MakeExecutor(std::make_shared<azul::async::StaticThreadPool>(1));
+
+    auto result = azul::async::Execute(executor, []() { throw std::invalid_argument(""); });
+
+    ASSERT_THROW(result.Get(), std::invalid_argument);
+}
+
+TEST_F(ExecutorTestFixture, Then_WithExecutor_ContinuationRunsOnExecutor)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    auto poolThread = threadPool->Execute([]() { return std::this_thread::get_id(); }).Get();
+
+    azul::async::Promise<int> promise;
+    auto future = promise.GetFuture();
+    auto continuation = future.Then(azul::async::MakeExecutor(threadPool), [](azul::async::Future<int> value) {
+        return std::make_pair(value.Get() + 1, std::this_thread::get_id());
+    });
+
+    promise.SetValue(1);
+    auto const result = continuation.Get();
+
+    ASSERT_EQ(2, result.first);
+    ASSERT_EQ(poolThread, result.second);
+}
+
+TEST_F(ExecutorTestFixture, Then_CallableReturningFuture_ResultFlattened)
+{
+    auto executor = azul::async::MakeExecutor(std::make_shared<azul::async::StaticThreadPool>(1));
+
+    auto result = azul::async::MakeReadyFuture(20).Then(executor, [](azul::async::Future<int> value) {
+        return azul::async::MakeReadyFuture(value.Get() + 22);
+    });
+
+    ASSERT_EQ(42, result.Get());
+}
+
+// an executor dropping its tasks, like a pool shutting down
+class DroppingExecutor final : public azul::async::Executor
+{
+public:
+    void Post(std::function<void()>) override
+    {
+
+    }
+
+    std::size_t Concurrency() const noexcept override
+    {
+        return 1u;
+    }
+};
+
+TEST_F(ExecutorTestFixture, Then_ExecutorDropsTask_BrokenPromise)
+{
+    auto result = azul::async::MakeReadyFuture().Then(std::make_shared<DroppingExecutor>(), [](azul::async::Future<void>) {});
+
+    ASSERT_THROW(result.Get(), azul::async::FutureError);
+}
+
+TEST_F(ExecutorTestFixture, Then_NullExecutor_Throws)
+{
+    ASSERT_THROW(azul::async::MakeReadyFuture().Then(nullptr, [](azul::async::Future<void>) {}), std::invalid_argument);
+}
@@ -0,0 +1,87 @@
+#include <gmock/gmock.h>
+#include <azul/async/Expected.hpp>
+#include <string>
+
+namespace
+{
+    enum class LookupError
+    {
+        NotFound,
+        Timeout
+    };
+}
+
+class ExpectedTestFixture : public testing::Test
+{
+};
+
+TEST_F(ExpectedTestFixture, Value_ExpectedHoldsValue_ReturnsValue)
+{
+    azul::async::Expected<int, LookupError> expected(42);
+
+    ASSERT_TRUE(expected.HasValue());
+    ASSERT_EQ(42, expected.Value());
+    ASSERT_THROW(expected.Error(), azul::async::BadExpectedAccess);
+}
+
+TEST_F(ExpectedTestFixture, Error_ExpectedHoldsError_ReturnsError)
+{
+    azul::async::Expected<int, LookupError> expected(azul::async::MakeUnexpected(LookupError::NotFound));
+
+    ASSERT_FALSE(expected);
+    ASSERT_EQ(LookupError::NotFound, expected.Error());
+    ASSERT_THROW(expected.Value(), azul::async::BadExpectedAccess);
+}
+
+TEST_F(ExpectedTestFixture, ThenValue_ValueSet_CallableInvoked)
+{
+    azul::async::Promise<azul::async::Expected<int, LookupError>> promise;
+
+    auto future = azul::async::ThenValue(promise.GetFuture(), [](int value) { return std::to_string(value); });
+    promise.SetValue(azul::async::Expected<int, LookupError>(42));
+
+    static_assert(std::is_same_v<azul::async::Future<azul::async::Expected<std::string, LookupError>>, decltype(future)>);
+    ASSERT_EQ("42", future.Get().Value());
+}
+
+TEST_F(ExpectedTestFixture, ThenValue_ErrorSet_CallableSkippedAndErrorForwarded)
+{
+    azul::async::Promise<azul::async::Expected<int, LookupError>> promise;
+    bool invoked = false;
+
+    auto future = azul::async::ThenValue(promise.GetFuture(), [&invoked](int value) { invoked = true; return value; });
+    auto future2 = azul::async::ThenValue(future, [&invoked](int) { invoked = true; });
+    promise.SetValue(azul::async::Expected<int, LookupError>(azul::async::MakeUnexpected(LookupError::Timeout)));
+
+    ASSERT_FALSE(invoked);
+    ASSERT_EQ(LookupError::Timeout, future2.Get().Error());
+}
+
+TEST_F(ExpectedTestFixture, ThenValue_CallableReturnsExpected_ResultNotWrappedTwice)
+{
+    auto future = azul::async::ThenValue(azul::async::MakeReadyFuture(azul::async::Expected<int, LookupError>(1)),
+        [](int) -> azul::async::Expected<int, LookupError> { return azul::async::MakeUnexpected(LookupError::NotFound); });
+
+    static_assert(std::is_same_v<azul::async::Future<azul::async::Expected<int, LookupError>>, decltype(future)>);
+    ASSERT_EQ(LookupError::NotFound, future.Get().Error());
+}
+
+TEST_F(ExpectedTestFixture, ThenError_ErrorSet_FallbackValueUsed)
+{
+    auto future = azul::async::ThenError(
+        azul::async::MakeReadyFuture(azul::async::Expected<int, LookupError>(azul::async::MakeUnexpected(LookupError::NotFound))),
+        [](LookupError) -> azul::async::Expected<int, LookupError> { return 7; });
+
+    ASSERT_EQ(7, future.Get().Value());
+}
+
+TEST_F(ExpectedTestFixture, ThenError_ValueSet_CallableSkipped)
+{
+    bool invoked = false;
+    auto future = azul::async::ThenError(
+        azul::async::MakeReadyFuture(azul::async::Expected<int, LookupError>(3)),
+        [&invoked](LookupError) -> azul::async::Expected<int, LookupError> { invoked = true; return 7; });
+
+    ASSERT_EQ(3, future.Get().Value());
+    ASSERT_FALSE(invoked);
+}
@@ -0,0 +1,125 @@
+#if defined(__linux__)
+
+#include <algorithm>
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/FiberExecutor.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class FiberExecutorTestFixture : public testing::Test
+{
+};
+
+TEST_F(FiberExecutorTestFixture, Execute_TaskReturningValue_ResultForwarded)
+{
+    azul::async::FiberExecutor executor(1);
+
+    auto result = executor.Execute([]() { return azul::async::FiberExecutor::RunningInFiber() ? 42 : 0; });
+
+    ASSERT_EQ(42, result.Get());
+    ASSERT_FALSE(azul::async::FiberExecutor::RunningInFiber());
+}
+
+TEST_F(FiberExecutorTestFixture, Execute_TaskThrowsException_ExceptionForwarded)
+{
+    azul::async::FiberExecutor executor(1);
+
+    auto result = executor.Execute([]() { throw std::invalid_argument(""); });
+
+    ASSERT_THROW(result.Get(), std::invalid_argument);
+}
+
+TEST_F(FiberExecutorTestFixture, Get_ManyFibersWaitingOnSingleThread_ThreadNotBlocked)
+{
+    azul::async::FiberExecutor executor(1);
+    azul::async::Promise<int> promise;
+    auto shared = promise.GetFuture();
+    std::atomic<int> waiting{ 0 };
+
+    std::vector<azul::async::Future<int>> results;
+    for (int i = 0; i < 2000; ++i)
+    {
+        results.emplace_back(executor.Execute([shared, &waiting, i]() {
+            ++waiting;
+            return shared.Get() + i;
+        }));
+    }
+
+    // a blocked thread would never let more than one fiber start waiting
+    while (waiting.load() < 2000)
+    {
+        std::this_thread::yield();
+    }
+    promise.SetValue(1);
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        ASSERT_EQ(i + 1, results[i].Get());
+    }
+}
+
+TEST_F(FiberExecutorTestFixture, Get_ResultProducedByLaterFiberOnSameThread_NoDeadlock)
+{
+    azul::async::FiberExecutor executor(1);
+    azul::async::Promise<int> promise;
+    auto future = promise.GetFuture();
+
+    auto consumer = executor.Execute([future]() { return future.Get() * 2; });
+    auto producer = executor.Execute([&promise]() { promise.SetValue(21); });
+
+    producer.Get();
+    ASSERT_EQ(42, consumer.Get());
+}
+
+TEST_F(FiberExecutorTestFixture, Wait_FiberSuspended_ResumedOnSameThread)
+{
+    azul::async::FiberExecutor executor(2);
+    azul::async::Promise<void> promise;
+    auto future = promise.GetFuture();
+
+    auto sameThread = executor.Execute([future]() {
+        auto const before = std::this_thread::get_id();
+        future.Wait();
+        return before == std::this_thread::get_id();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    promise.SetValue();
+
+    ASSERT_TRUE(sameThread.Get());
+}
+
+TEST_F(FiberExecutorTestFixture, Get_PromiseBroken_FiberResumedWithError)
+{
+    azul::async::FiberExecutor executor(1);
+    auto promise = std::make_unique<azul::async::Promise<int>>();
+    auto future = promise->GetFuture();
+
+    auto result = executor.Execute([future]() { return future.Get(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    promise.reset();
+
+    ASSERT_THROW(result.Get(), azul::async::FutureError);
+}
+
+TEST_F(FiberExecutorTestFixture, Then_ContinuationWaitsInsideFiber_ChainCompleted)
+{
+    azul::async::FiberExecutor executor(1);
+    azul::async::Promise<int> first;
+    azul::async::Promise<int> second;
+    auto firstFuture = first.GetFuture();
+    auto secondFuture = second.GetFuture();
+
+    auto result = executor.Execute([firstFuture, secondFuture]() mutable {
+        return firstFuture.Then([secondFuture](azul::async::Future<int> f) { return f.Get() + secondFuture.Get(); }).Get();
+    });
+
+    first.SetValue(1);
+    second.SetValue(2);
+
+    ASSERT_EQ(3, result.Get());
+}
+
+#endif
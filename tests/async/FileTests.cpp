@@ -0,0 +1,186 @@
+#if defined(__linux__)
+
+#include <gmock/gmock.h>
+#include <azul/async/File.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+class FileTestFixture : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char path[] = "/tmp/azul_file_test_XXXXXX";
+        ::close(::mkstemp(path));
+        _path = path;
+    }
+
+    void TearDown() override
+    {
+        ::unlink(_path.c_str());
+    }
+
+    // every test runs against io_uring (if supported) and the blocking fallback
+    static std::vector<std::shared_ptr<azul::async::IoService>> Services(azul::async::IoServiceOptions options = { })
+    {
+        std::vector<std::shared_ptr<azul::async::IoService>> services;
+        services.emplace_back(std::make_shared<azul::async::IoService>(nullptr, options));
+        options.preferIoUring = false;
+        services.emplace_back(std::make_shared<azul::async::IoService>(nullptr, options));
+        return services;
+    }
+
+    std::string _path;
+};
+
+TEST_F(FileTestFixture, IoService_PreferIoUringDisabled_BlockingFallbackUsed)
+{
+    azul::async::IoServiceOptions options;
+    options.preferIoUring = false;
+    azul::async::IoService service(nullptr, options);
+
+    ASSERT_FALSE(service.UsesIoUring());
+}
+
+TEST_F(FileTestFixture, WriteAt_ReadAt_DataRoundTrips)
+{
+    for (auto const& service : Services())
+    {
+        auto file = azul::async::File::Open(service, _path, O_RDWR | O_TRUNC);
+        std::string const data = "hello io";
+
+        ASSERT_EQ(data.size(), file.WriteAt(data.data(), data.size(), 10).Get());
+
+        std::string buffer(data.size(), '\0');
+        ASSERT_EQ(data.size(), file.ReadAt(buffer.data(), buffer.size(), 10).Get());
+        ASSERT_EQ(data, buffer);
+    }
+}
+
+TEST_F(FileTestFixture, ReadAt_BeyondEndOfFile_ZeroBytesRead)
+{
+    for (auto const& service : Services())
+    {
+        auto file = azul::async::File::Open(service, _path, O_RDWR | O_TRUNC);
+        char buffer[16];
+
+        ASSERT_EQ(0u, file.ReadAt(buffer, sizeof(buffer), 1000).Get());
+    }
+}
+
+TEST_F(FileTestFixture, ReadAt_WriteOnlyFile_SystemError)
+{
+    for (auto const& service : Services())
+    {
+        auto file = azul::async::File::Open(service, _path, O_WRONLY);
+        char buffer[16];
+
+        ASSERT_THROW(file.ReadAt(buffer, sizeof(buffer), 0).Get(), std::system_error);
+    }
+}
+
+TEST_F(FileTestFixture, Fsync_AfterWrite_Completes)
+{
+    for (auto const& service : Services())
+    {
+        auto file = azul::async::File::Open(service, _path, O_RDWR | O_TRUNC);
+        ASSERT_EQ(3u, file.WriteAt("abc", 3, 0).Get());
+
+        file.Fsync().Get();
+    }
+}
+
+TEST_F(FileTestFixture, ReadAt_ManyConcurrentReads_AllBlocksReadCorrectly)
+{
+    const std::size_t blocks = 1000;
+    const std::size_t blockSize = 512;
+
+    std::vector<char> data(blocks * blockSize);
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<char>(i / blockSize);
+    }
+
+    azul::async::IoServiceOptions options;
+    options.queueDepth = 32;
+    for (auto const& service : Services(options))
+    {
+        auto file = azul::async::File::Open(service, _path, O_RDWR | O_TRUNC);
+        ASSERT_EQ(data.size(), file.WriteAt(data.data(), data.size(), 0).Get());
+
+        // more reads than the submission queue holds
+        std::vector<char> result(data.size());
+        std::vector<azul::async::Future<std::size_t>> reads;
+        for (std::size_t i = 0; i < blocks; ++i)
+        {
+            reads.emplace_back(file.ReadAt(result.data() + i * blockSize, blockSize, i * blockSize));
+        }
+
+        for (auto& read : reads)
+        {
+            ASSERT_EQ(blockSize, read.Get());
+        }
+        ASSERT_TRUE(data == result);
+    }
+}
+
+TEST_F(FileTestFixture, ReadAt_RegisteredBuffer_DataRead)
+{
+    azul::async::IoServiceOptions options;
+    options.registeredBuffers = 2;
+    options.registeredBufferSize = 4096;
+    for (auto const& service : Services(options))
+    {
+        auto file = azul::async::File::Open(service, _path, O_RDWR | O_TRUNC);
+        ASSERT_EQ(5u, file.WriteAt("fixed", 5, 0).Get());
+
+        auto buffer = service->TryAcquireBuffer();
+        ASSERT_TRUE(buffer.has_value());
+        ASSERT_EQ(4096u, buffer->Size());
+
+        ASSERT_EQ(5u, file.ReadAt(*buffer, buffer->Size(), 0).Get());
+        ASSERT_EQ(std::string("fixed"), std::string(reinterpret_cast<char const*>(buffer->Data()), 5));
+    }
+}
+
+TEST_F(FileTestFixture, TryAcquireBuffer_AllLeased_NothingAcquiredUntilReturned)
+{
+    azul::async::IoServiceOptions options;
+    options.registeredBuffers = 1;
+    azul::async::IoService service(nullptr, options);
+
+    auto buffer = service.TryAcquireBuffer();
+    ASSERT_TRUE(buffer.has_value());
+    ASSERT_FALSE(service.TryAcquireBuffer().has_value());
+
+    buffer.reset();
+    ASSERT_TRUE(service.TryAcquireBuffer().has_value());
+}
+
+TEST_F(FileTestFixture, ReadAt_CompletionExecutor_ContinuationRunsOnExecutor)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    auto const poolThread = threadPool->Execute([]() { return std::this_thread::get_id(); }).Get();
+    auto service = std::make_shared<azul::async::IoService>(azul::async::MakeExecutor(threadPool));
+
+    auto file = azul::async::File::Open(service, _path, O_RDWR | O_TRUNC);
+    char buffer[4];
+    auto completedOn = file.ReadAt(buffer, sizeof(buffer), 0).Then([](azul::async::Future<std::size_t>) {
+        return std::this_thread::get_id();
+    });
+
+    ASSERT_EQ(poolThread, completedOn.Get());
+}
+
+TEST_F(FileTestFixture, Open_MissingFile_SystemError)
+{
+    auto service = std::make_shared<azul::async::IoService>();
+
+    ASSERT_THROW(azul::async::File::Open(service, "/nonexistent/azul/file", O_RDONLY), std::system_error);
+}
+
+#endif
@@ -1,7 +1,10 @@
+#include <algorithm>
+#include <cstdint>
 #include <gmock/gmock.h>
 #include <azul/async/Future.hpp>
 #include <stdexcept>
 #include <thread>
+#include <vector>
 
 class FutureTestFixture : public testing::Test
 {
@@ -315,3 +318,231 @@ TEST_F(FutureTestFixture, Operators_BooleanExpression2_ResultCorrect)
     ASSERT_TRUE(resultFuture.IsReady());
 }
 
+
+TEST_F(FutureTestFixture, Then_ContinuationReturningFuture_ResultUnwrapped)
+{
+    azul::async::Promise<int> promise;
+    azul::async::Promise<int> innerPromise;
+    auto innerFuture = innerPromise.GetFuture();
+
+    auto future = promise.GetFuture().Then([innerFuture](auto f) mutable {
+        return innerFuture.Then([value = f.Get()](auto inner){ return value + inner.Get(); });
+    });
+
+    static_assert(std::is_same_v<azul::async::Future<int>, decltype(future)>);
+
+    promise.SetValue(40);
+    ASSERT_FALSE(future.IsReady());
+
+    innerPromise.SetValue(2);
+    ASSERT_TRUE(future.IsReady());
+    ASSERT_EQ(42, future.Get());
+}
+
+TEST_F(FutureTestFixture, Then_ContinuationReturningVoidFuture_ResultUnwrapped)
+{
+    azul::async::Promise<void> promise;
+    azul::async::Promise<void> innerPromise;
+    auto innerFuture = innerPromise.GetFuture();
+
+    auto future = promise.GetFuture().Then([innerFuture](auto) { return innerFuture; });
+
+    static_assert(std::is_same_v<azul::async::Future<void>, decltype(future)>);
+
+    promise.SetValue();
+    ASSERT_FALSE(future.IsReady());
+
+    innerPromise.SetValue();
+    ASSERT_NO_THROW(future.Get());
+}
+
+TEST_F(FutureTestFixture, Then_InnerFutureHoldsException_ExceptionForwarded)
+{
+    azul::async::Promise<int> promise;
+    azul::async::Promise<int> innerPromise;
+    auto innerFuture = innerPromise.GetFuture();
+
+    auto future = promise.GetFuture().Then([innerFuture](auto) { return innerFuture; });
+
+    promise.SetValue(1);
+    innerPromise.SetException(std::make_exception_ptr(std::runtime_error("")));
+
+    ASSERT_THROW(future.Get(), std::runtime_error);
+}
+
+TEST_F(FutureTestFixture, Then_InnerPromiseBroken_ResultFutureThrowsFutureError)
+{
+    azul::async::Promise<int> promise;
+    azul::async::Future<int> future;
+    {
+        azul::async::Promise<int> innerPromise;
+        auto innerFuture = innerPromise.GetFuture();
+        future = promise.GetFuture().Then([innerFuture](auto) { return innerFuture; });
+        promise.SetValue(1);
+    }
+
+    ASSERT_THROW(future.Get(), azul::async::FutureError);
+}
+
+TEST_F(FutureTestFixture, MakeReadyFuture_Value_ReadyWithValue)
+{
+    auto future = azul::async::MakeReadyFuture(42);
+
+    ASSERT_TRUE(future.Valid());
+    ASSERT_TRUE(future.IsReady());
+    ASSERT_TRUE(future.WaitFor(std::chrono::milliseconds(0)));
+    ASSERT_EQ(42, future.Get());
+    ASSERT_EQ(0u, future.NumberOfContinuations());
+}
+
+TEST_F(FutureTestFixture, MakeReadyFuture_Void_Ready)
+{
+    auto future = azul::async::MakeReadyFuture();
+
+    ASSERT_TRUE(future.IsReady());
+    ASSERT_TRUE(future.WaitFor(std::chrono::milliseconds(0)));
+    ASSERT_NO_THROW(future.Wait());
+    ASSERT_NO_THROW(future.Get());
+}
+
+TEST_F(FutureTestFixture, MakeExceptionalFuture_Exception_RethrowsException)
+{
+    auto future = azul::async::MakeExceptionalFuture<int>(std::runtime_error(""));
+
+    ASSERT_TRUE(future.IsReady());
+    ASSERT_THROW(future.Get(), std::runtime_error);
+    ASSERT_THROW(future.Get(), std::runtime_error);
+}
+
+TEST_F(FutureTestFixture, Then_ReadyFuture_CallableInvokedImmediately)
+{
+    bool invoked = false;
+    auto future = azul::async::MakeReadyFuture(20).Then([&invoked](auto f){ invoked = true; return f.Get() + 22; });
+
+    ASSERT_TRUE(invoked);
+    ASSERT_TRUE(future.IsReady());
+    ASSERT_EQ(42, future.Get());
+}
+
+TEST_F(FutureTestFixture, Then_ReadyFutureCallableThrows_ResultHoldsException)
+{
+    auto future = azul::async::MakeReadyFuture().Then([](auto){ throw std::invalid_argument(""); });
+
+    ASSERT_THROW(future.Get(), std::invalid_argument);
+}
+
+TEST_F(FutureTestFixture, Then_ContinuationReturningReadyFuture_ResultUnwrapped)
+{
+    azul::async::Promise<int> promise;
+    auto future = promise.GetFuture().Then([](auto f){ return azul::async::MakeReadyFuture(f.Get() * 2); });
+
+    promise.SetValue(21);
+
+    ASSERT_EQ(42, future.Get());
+}
+
+TEST_F(FutureTestFixture, WhenAll_ReadyFutures_ResultReady)
+{
+    auto futureA = azul::async::MakeReadyFuture(1);
+    auto futureB = azul::async::MakeReadyFuture();
+
+    ASSERT_TRUE(azul::async::WhenAll(futureA, futureB).IsReady());
+}
+
+TEST_F(FutureTestFixture, Then_LongChainCompleted_StackDepthBounded)
+{
+    azul::async::Promise<int> promise;
+    auto future = promise.GetFuture();
+
+    const int chainLength = 2000;
+    std::vector<std::uintptr_t> stackAddresses;
+
+    for (int i = 0; i < chainLength; ++i)
+    {
+        future = future.Then([&stackAddresses](auto f) {
+            int local = 0;
+            stackAddresses.push_back(reinterpret_cast<std::uintptr_t>(&local));
+            return f.Get() + 1;
+        });
+    }
+
+    promise.SetValue(0);
+
+    ASSERT_EQ(chainLength, future.Get());
+    ASSERT_EQ(static_cast<std::size_t>(chainLength), stackAddresses.size());
+
+    const auto [minAddress, maxAddress] = std::minmax_element(stackAddresses.begin(), stackAddresses.end());
+    ASSERT_LT(*maxAddress - *minAddress, 4096u);
+}
+
+TEST_F(FutureTestFixture, Then_ManyContinuationsCompletedInsideContinuation_StackDepthBounded)
+{
+    azul::async::Promise<int> trigger;
+    azul::async::Promise<int> promise;
+    auto future = promise.GetFuture();
+
+    const int fanOut = 20000;
+    std::vector<std::uintptr_t> stackAddresses;
+    std::vector<azul::async::Future<int>> results;
+    results.reserve(fanOut);
+
+    for (int i = 0; i < fanOut; ++i)
+    {
+        results.push_back(future.Then([&stackAddresses](auto f) {
+            int local = 0;
+            stackAddresses.push_back(reinterpret_cast<std::uintptr_t>(&local));
+            return f.Get() + 1;
+        }));
+    }
+
+    auto completed = trigger.GetFuture().Then([&promise](auto f) { promise.SetValue(f.Get()); });
+    trigger.SetValue(1);
+    completed.Get();
+
+    for (auto& result : results)
+    {
+        ASSERT_EQ(2, result.Get());
+    }
+    ASSERT_EQ(static_cast<std::size_t>(fanOut), stackAddresses.size());
+
+    const auto [minAddress, maxAddress] = std::minmax_element(stackAddresses.begin(), stackAddresses.end());
+    ASSERT_LT(*maxAddress - *minAddress, 4096u);
+}
+
+TEST_F(FutureTestFixture, Then_InnerFutureDroppedBeforeQueuedContinuationRuns_ResultForwarded)
+{
+    azul::async::Promise<void> outer;
+    auto inner = std::make_unique<azul::async::Promise<int>>();
+
+    auto result = outer.GetFuture().Then([&inner](auto) { return inner->GetFuture(); });
+    outer.SetValue();
+
+    // completing the inner promise within a continuation queues the forwarding on the trampoline,
+    // the inner state has no owner left (apart from the forwarding) once the promise is destroyed
+    azul::async::Promise<void> trigger;
+    auto completed = trigger.GetFuture().Then([&inner](auto) {
+        inner->SetValue(42);
+        inner.reset();
+    });
+    trigger.SetValue();
+
+    completed.Get();
+    ASSERT_EQ(42, result.Get());
+}
+
+TEST_F(FutureTestFixture, Get_InsideContinuationOnResultOfQueuedContinuation_DoesNotDeadlock)
+{
+    azul::async::Promise<int> promiseA;
+    azul::async::Promise<int> promiseB;
+    auto futureB = promiseB.GetFuture().Then([](auto f){ return f.Get() * 2; });
+
+    auto result = promiseA.GetFuture().Then([&promiseB, futureB](auto f) {
+        // the continuation of promiseB is queued on the trampoline while this continuation runs
+        promiseB.SetValue(f.Get());
+        return futureB.Get();
+    });
+
+    promiseA.SetValue(21);
+
+    ASSERT_EQ(42, result.Get());
+}
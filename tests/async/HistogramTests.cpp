@@ -0,0 +1,82 @@
+#include <gmock/gmock.h>
+#include <azul/async/Histogram.hpp>
+
+class HistogramTestFixture : public testing::Test
+{
+};
+
+TEST_F(HistogramTestFixture, Snapshot_NoValues_Empty)
+{
+    azul::async::Histogram histogram;
+
+    auto const snapshot = histogram.Snapshot();
+
+    ASSERT_EQ(0u, snapshot.count);
+    ASSERT_EQ(0u, snapshot.min);
+    ASSERT_EQ(0u, snapshot.Percentile(99));
+}
+
+TEST_F(HistogramTestFixture, Record_Values_SummaryAndBucketsUpdated)
+{
+    azul::async::Histogram histogram;
+
+    histogram.Record(0);
+    histogram.Record(1);
+    histogram.Record(5);
+    histogram.Record(6);
+
+    auto const snapshot = histogram.Snapshot();
+    ASSERT_EQ(4u, snapshot.count);
+    ASSERT_EQ(12u, snapshot.sum);
+    ASSERT_EQ(0u, snapshot.min);
+    ASSERT_EQ(6u, snapshot.max);
+    ASSERT_DOUBLE_EQ(3.0, snapshot.Mean());
+    ASSERT_EQ(1u, snapshot.buckets[0]);
+    ASSERT_EQ(1u, snapshot.buckets[1]);
+    ASSERT_EQ(2u, snapshot.buckets[3]);
+}
+
+TEST_F(HistogramTestFixture, Percentile_SkewedValues_UpperBoundOfBucket)
+{
+    azul::async::Histogram histogram;
+
+    for (int i = 0; i < 99; ++i)
+    {
+        histogram.Record(10);
+    }
+    histogram.Record(1000);
+
+    auto const snapshot = histogram.Snapshot();
+    ASSERT_EQ(15u, snapshot.Percentile(50));
+    ASSERT_EQ(15u, snapshot.Percentile(99));
+    ASSERT_EQ(1000u, snapshot.Percentile(100));
+}
+
+TEST_F(HistogramTestFixture, Percentile_SubBuckets_BoundedRelativeError)
+{
+    azul::async::Histogram histogram(3);
+
+    for (int i = 0; i < 99; ++i)
+    {
+        histogram.Record(1000);
+    }
+    histogram.Record(1u << 20);
+
+    auto const snapshot = histogram.Snapshot();
+    ASSERT_EQ(3u, snapshot.subBucketBits);
+    ASSERT_EQ(1023u, snapshot.Percentile(50));
+    ASSERT_EQ(1023u, snapshot.Percentile(99));
+    ASSERT_EQ(1u << 20, snapshot.Percentile(100));
+
+    for (std::uint64_t value : { 0ull, 7ull, 8ull, 9ull, 1000ull, 123456789ull, ~0ull })
+    {
+        auto const upperBound = snapshot.UpperBoundOf(azul::async::HistogramSnapshot::BucketOf(value, 3));
+        ASSERT_GE(upperBound, value);
+        ASSERT_LE(upperBound - value, value / 8);
+    }
+}
+
+TEST_F(HistogramTestFixture, Constructor_TooManySubBucketBits_Throws)
+{
+    ASSERT_THROW(azul::async::Histogram(17), std::invalid_argument);
+}
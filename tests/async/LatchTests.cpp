@@ -0,0 +1,54 @@
+#include <gmock/gmock.h>
+#include <azul/async/Latch.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <stdexcept>
+
+class LatchTestFixture : public testing::Test
+{
+};
+
+TEST_F(LatchTestFixture, Wait_CountReachesZero_FutureReady)
+{
+    azul::async::Latch latch(2);
+    auto future = latch.Wait();
+
+    latch.CountDown();
+    ASSERT_FALSE(future.IsReady());
+    ASSERT_FALSE(latch.TryWait());
+
+    latch.CountDown();
+    ASSERT_TRUE(future.IsReady());
+    ASSERT_TRUE(latch.TryWait());
+}
+
+TEST_F(LatchTestFixture, Wait_ZeroCount_ReadyImmediately)
+{
+    azul::async::Latch latch(0);
+
+    ASSERT_TRUE(latch.Wait().IsReady());
+}
+
+TEST_F(LatchTestFixture, CountDown_BelowZero_ThrowsLogicError)
+{
+    azul::async::Latch latch(1);
+
+    ASSERT_THROW(latch.CountDown(2), std::logic_error);
+    ASSERT_FALSE(latch.TryWait());
+
+    latch.CountDown();
+    ASSERT_TRUE(latch.Wait().IsReady());
+}
+
+TEST_F(LatchTestFixture, CountDown_FromPoolThreads_WaitCompletes)
+{
+    azul::async::StaticThreadPool threadPool(4);
+    azul::async::Latch latch(100);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        threadPool.Execute([&latch]() { latch.CountDown(); });
+    }
+
+    latch.Wait().Get();
+    ASSERT_TRUE(latch.TryWait());
+}
@@ -0,0 +1,126 @@
+#include <gmock/gmock.h>
+#include <azul/async/Lazy.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/Strand.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+
+namespace lazy = azul::async::lazy;
+
+class LazyTestFixture : public testing::Test
+{
+};
+
+TEST_F(LazyTestFixture, SyncWait_Just_ReturnsValue)
+{
+    ASSERT_EQ(42, lazy::SyncWait(lazy::Just(42)));
+}
+
+TEST_F(LazyTestFixture, SyncWait_ThenChain_StagesFused)
+{
+    bool started = false;
+    auto sender = lazy::Just(20)
+        | lazy::Then([&started](int value) { started = true; return value + 1; })
+        | lazy::Then([](int value) { return std::to_string(value * 2); });
+
+    ASSERT_FALSE(started);
+    ASSERT_EQ("42", lazy::SyncWait(std::move(sender)));
+    ASSERT_TRUE(started);
+}
+
+TEST_F(LazyTestFixture, SyncWait_VoidStages_Completes)
+{
+    int calls = 0;
+    auto sender = lazy::Just()
+        | lazy::Then([&calls]() { ++calls; })
+        | lazy::Then([&calls]() { ++calls; return calls; });
+
+    ASSERT_EQ(2, lazy::SyncWait(std::move(sender)));
+}
+
+TEST_F(LazyTestFixture, SyncWait_StageThrows_ExceptionRethrownAndFollowingStagesSkipped)
+{
+    bool skippedStageCalled = false;
+    auto sender = lazy::Just(1)
+        | lazy::Then([](int) -> int { throw std::invalid_argument(""); })
+        | lazy::Then([&skippedStageCalled](int value) { skippedStageCalled = true; return value; });
+
+    ASSERT_THROW(lazy::SyncWait(std::move(sender)), std::invalid_argument);
+    ASSERT_FALSE(skippedStageCalled);
+}
+
+TEST_F(LazyTestFixture, On_ThreadPool_FollowingStagesRunOnPool)
+{
+    azul::async::StaticThreadPool threadPool(1);
+
+    auto sender = lazy::Just(1)
+        | lazy::On(threadPool)
+        | lazy::Then([](int) { return std::this_thread::get_id(); });
+
+    ASSERT_NE(std::this_thread::get_id(), lazy::SyncWait(std::move(sender)));
+}
+
+TEST_F(LazyTestFixture, On_Strand_FollowingStagesRunOnStrand)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    azul::async::Strand<azul::async::StaticThreadPool> strand(threadPool);
+
+    auto sender = lazy::Just(1)
+        | lazy::On(strand)
+        | lazy::Then([&strand](int) { return strand.RunningInThisThread(); });
+
+    ASSERT_TRUE(lazy::SyncWait(std::move(sender)));
+}
+
+TEST_F(LazyTestFixture, WhenAll_MultipleSenders_TupleOfValues)
+{
+    azul::async::StaticThreadPool threadPool(2);
+
+    auto sender = lazy::WhenAll(
+        lazy::Just(1) | lazy::On(threadPool) | lazy::Then([](int v) { return v + 1; }),
+        lazy::Just(std::string("a")) | lazy::On(threadPool));
+
+    ASSERT_EQ(std::make_tuple(2, std::string("a")), lazy::SyncWait(std::move(sender)));
+}
+
+TEST_F(LazyTestFixture, WhenAll_OneSenderFails_ErrorReported)
+{
+    auto sender = lazy::WhenAll(
+        lazy::Just(1),
+        lazy::Just(2) | lazy::Then([](int) -> int { throw std::runtime_error(""); }));
+
+    ASSERT_THROW(lazy::SyncWait(std::move(sender)), std::runtime_error);
+}
+
+TEST_F(LazyTestFixture, ToFuture_Pipeline_FutureHoldsResult)
+{
+    azul::async::StaticThreadPool threadPool(1);
+
+    auto future = lazy::ToFuture(lazy::Just(21) | lazy::On(threadPool) | lazy::Then([](int v) { return v * 2; }));
+
+    ASSERT_EQ(42, future.Get());
+}
+
+TEST_F(LazyTestFixture, FromFuture_PromiseSetLater_PipelineContinues)
+{
+    azul::async::Promise<int> promise;
+
+    auto future = lazy::ToFuture(lazy::FromFuture(promise.GetFuture()) | lazy::Then([](int v) { return v + 2; }));
+    ASSERT_FALSE(future.IsReady());
+
+    promise.SetValue(40);
+    ASSERT_EQ(42, future.Get());
+}
+
+TEST_F(LazyTestFixture, FromFuture_PromiseBroken_ErrorReported)
+{
+    azul::async::Future<int> future;
+    {
+        azul::async::Promise<int> promise;
+        future = lazy::ToFuture(lazy::FromFuture(promise.GetFuture()));
+    }
+
+    ASSERT_THROW(future.Get(), azul::async::FutureError);
+}
@@ -0,0 +1,142 @@
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/Executor.hpp>
+#include <azul/async/Future.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <memory_resource>
+
+namespace
+{
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t Allocations() const
+        {
+            return _allocations;
+        }
+
+        std::size_t Outstanding() const
+        {
+            return _allocations - _deallocations;
+        }
+
+    private:
+        std::atomic<std::size_t> _allocations{ 0 };
+        std::atomic<std::size_t> _deallocations{ 0 };
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++_allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            ++_deallocations;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+class MemoryResourceTestFixture : public testing::Test
+{
+};
+
+TEST_F(MemoryResourceTestFixture, Promise_WithResource_StateAllocatedFromResource)
+{
+    CountingResource resource;
+    {
+        azul::async::Promise<int> promise(&resource);
+        auto future = promise.GetFuture();
+        promise.SetValue(42);
+
+        ASSERT_EQ(42, future.Get());
+        ASSERT_EQ(1u, resource.Allocations());
+    }
+    ASSERT_EQ(0u, resource.Outstanding());
+}
+
+TEST_F(MemoryResourceTestFixture, Then_StateWithResource_ContinuationStateUsesSameResource)
+{
+    CountingResource resource;
+    {
+        azul::async::Promise<int> promise(&resource);
+        auto future = promise.GetFuture().Then([](auto f){ return f.Get() + 1; });
+        const auto allocationsAfterThen = resource.Allocations();
+
+        promise.SetValue(41);
+
+        ASSERT_EQ(42, future.Get());
+        ASSERT_GT(allocationsAfterThen, 1u);
+    }
+    ASSERT_EQ(0u, resource.Outstanding());
+}
+
+TEST_F(MemoryResourceTestFixture, ThenWithExecutor_StateWithResource_ScheduledStateUsesSameResource)
+{
+    CountingResource resource;
+    {
+        azul::async::Promise<int> promise(&resource);
+        auto future = promise.GetFuture().Then(std::make_shared<azul::async::InlineExecutor>(), [](auto f){ return f.Get() + 1; });
+        const auto allocationsAfterThen = resource.Allocations();
+
+        promise.SetValue(41);
+
+        ASSERT_EQ(42, future.Get());
+        ASSERT_GT(resource.Allocations(), allocationsAfterThen);
+    }
+    ASSERT_EQ(0u, resource.Outstanding());
+}
+
+TEST_F(MemoryResourceTestFixture, WhenAll_WithResource_StateAllocatedFromResource)
+{
+    CountingResource resource;
+    azul::async::Promise<void> promise;
+    {
+        auto future = azul::async::WhenAll(std::allocator_arg, &resource, promise.GetFuture());
+        ASSERT_GT(resource.Allocations(), 0u);
+
+        promise.SetValue();
+        ASSERT_TRUE(future.IsReady());
+    }
+}
+
+TEST_F(MemoryResourceTestFixture, Execute_PoolOptionResource_TasksAllocatedFromResource)
+{
+    CountingResource resource;
+    {
+        azul::async::StaticThreadPoolOptions options;
+        options.memoryResource = &resource;
+        azul::async::StaticThreadPool executor(2, options);
+
+        auto future = executor.Execute([](){ return 42; });
+        ASSERT_EQ(42, future.Get());
+        ASSERT_GT(resource.Allocations(), 0u);
+    }
+    ASSERT_EQ(0u, resource.Outstanding());
+}
+
+TEST_F(MemoryResourceTestFixture, Execute_RequestScopedArena_AllFuturesBackedByArena)
+{
+    CountingResource upstream;
+    {
+        std::pmr::monotonic_buffer_resource arena(&upstream);
+        std::pmr::synchronized_pool_resource requestResource(&arena);
+
+        // destroyed first, workers may still hold the last reference to a finished task
+        azul::async::StaticThreadPool executor(2);
+
+        auto first = executor.Execute(std::allocator_arg, &requestResource, [](){ return 20; });
+        auto second = executor.Execute(std::allocator_arg, &requestResource, [](){ return 22; }, first);
+        auto sum = second.Then([first](auto f){ return first.Get() + f.Get(); });
+
+        ASSERT_EQ(42, sum.Get());
+        ASSERT_GT(upstream.Allocations(), 0u);
+    }
+    ASSERT_EQ(0u, upstream.Outstanding());
+}
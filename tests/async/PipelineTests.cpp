@@ -0,0 +1,171 @@
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/Pipeline.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class PipelineTestFixture : public testing::Test
+{
+protected:
+    std::shared_ptr<azul::async::StaticThreadPool> _threadPool = std::make_shared<azul::async::StaticThreadPool>(4);
+};
+
+namespace
+{
+    struct Record
+    {
+        int id = 0;
+        std::string text;
+    };
+
+    azul::async::Pipeline<Record>::Source CountTo(int n)
+    {
+        auto next = std::make_shared<int>(0);
+        return [next, n](Record& record) {
+            if (*next == n)
+            {
+                return false;
+            }
+            record.id = (*next)++;
+            return true;
+        };
+    }
+}
+
+TEST_F(PipelineTestFixture, Run_SerialInOrderStage_ItemsWrittenInSourceOrder)
+{
+    azul::async::Pipeline<Record> pipeline(_threadPool, 8);
+    std::vector<int> written;
+
+    pipeline
+        .AddStage(azul::async::StageMode::Parallel, [](Record& record) { record.text = std::to_string(record.id); })
+        .AddStage(azul::async::StageMode::SerialInOrder, [&written](Record& record) { written.push_back(std::stoi(record.text)); });
+
+    ASSERT_EQ(1000u, pipeline.Run(CountTo(1000)).Get());
+
+    ASSERT_EQ(1000u, written.size());
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(i, written[i]);
+    }
+}
+
+TEST_F(PipelineTestFixture, Run_SerialOutOfOrderStage_NeverConcurrentAndAllItemsSeen)
+{
+    azul::async::Pipeline<Record> pipeline(_threadPool, 8);
+    std::atomic<int> inside{ 0 };
+    bool overlapped = false;
+    std::set<int> seen;
+
+    pipeline.AddStage(azul::async::StageMode::SerialOutOfOrder, [&](Record& record) {
+        overlapped |= ++inside > 1;
+        seen.insert(record.id);
+        --inside;
+    });
+
+    ASSERT_EQ(500u, pipeline.Run(CountTo(500)).Get());
+    ASSERT_FALSE(overlapped);
+    ASSERT_EQ(500u, seen.size());
+}
+
+TEST_F(PipelineTestFixture, Run_TokenLimit_InFlightItemsBounded)
+{
+    azul::async::Pipeline<Record> pipeline(_threadPool, 3);
+    std::atomic<int> inFlight{ 0 };
+    std::atomic<int> maximum{ 0 };
+    std::set<Record*> buffers;
+    std::mutex buffersMutex;
+
+    auto source = CountTo(200);
+    pipeline
+        .AddStage(azul::async::StageMode::Parallel, [&](Record& record) {
+            auto const current = ++inFlight;
+            int expected = maximum.load();
+            while (current > expected && !maximum.compare_exchange_weak(expected, current))
+            {
+            }
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            buffers.insert(&record);
+        })
+        .AddStage(azul::async::StageMode::SerialInOrder, [&](Record&) { --inFlight; });
+
+    ASSERT_EQ(200u, pipeline.Run(source).Get());
+    ASSERT_LE(maximum.load(), 3);
+    // the buffers of the tokens are reused for all items
+    ASSERT_LE(buffers.size(), 3u);
+}
+
+TEST_F(PipelineTestFixture, Run_StageThrows_ExceptionForwardedAndPipelineStops)
+{
+    azul::async::Pipeline<Record> pipeline(_threadPool, 4);
+    std::atomic<int> produced{ 0 };
+
+    pipeline
+        .AddStage(azul::async::StageMode::Parallel, [](Record& record) {
+            if (record.id == 10)
+            {
+                throw std::runtime_error("parse error");
+            }
+        })
+        .AddStage(azul::async::StageMode::SerialInOrder, [](Record&) { });
+
+    auto source = CountTo(1000000);
+    ASSERT_THROW(pipeline.Run([&](Record& record) { ++produced; return source(record); }).Get(), std::runtime_error);
+    ASSERT_LT(produced.load(), 1000000);
+}
+
+TEST_F(PipelineTestFixture, Run_CalledAgain_PipelineReused)
+{
+    azul::async::Pipeline<Record> pipeline(_threadPool, 2);
+    std::atomic<int> sum{ 0 };
+    pipeline.AddStage(azul::async::StageMode::Parallel, [&sum](Record& record) { sum += record.id; });
+
+    ASSERT_EQ(10u, pipeline.Run(CountTo(10)).Get());
+    ASSERT_EQ(10u, pipeline.Run(CountTo(10)).Get());
+    ASSERT_EQ(90, sum.load());
+}
+
+TEST_F(PipelineTestFixture, Run_BoundedPoolRejectsStart_FailedAndPipelineReusable)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 4;
+    options.overflowPolicy = azul::async::OverflowPolicy::Reject;
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1, options);
+    azul::async::Pipeline<Record> pipeline(threadPool, 1);
+    std::atomic<int> sum{ 0 };
+    pipeline.AddStage(azul::async::StageMode::Parallel, [&sum](Record& record) { sum += record.id; });
+
+    azul::async::Promise<void> gate;
+    auto running = std::make_shared<azul::async::Promise<void>>();
+    auto blocker = threadPool->Execute([&gate, running]() { running->SetValue(); gate.GetFuture().Wait(); });
+    running->GetFuture().Wait();
+    std::vector<azul::async::Future<void>> queued;
+    for (int i = 0; i < 4; ++i)
+    {
+        queued.push_back(threadPool->Execute([]() {}));
+    }
+
+    try
+    {
+        pipeline.Run(CountTo(10)).Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::QueueFull, error.ErrorCode());
+    }
+
+    gate.SetValue();
+    blocker.Wait();
+    for (auto& future : queued)
+    {
+        future.Wait();
+    }
+
+    ASSERT_EQ(10u, pipeline.Run(CountTo(10)).Get());
+    ASSERT_EQ(45, sum.load());
+}
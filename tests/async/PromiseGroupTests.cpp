@@ -0,0 +1,181 @@
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/Executor.hpp>
+#include <azul/async/PromiseGroup.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class PromiseGroupTestFixture : public testing::Test
+{
+};
+
+TEST_F(PromiseGroupTestFixture, SetValues_AllPromises_FuturesHoldValuesInOrder)
+{
+    azul::async::PromiseGroup<int> group(3);
+    auto futures = group.GetFutures();
+
+    group.SetValues(std::vector<int>{ 1, 2, 3 });
+
+    ASSERT_EQ(1, futures[0].Get());
+    ASSERT_EQ(2, futures[1].Get());
+    ASSERT_EQ(3, futures[2].Get());
+}
+
+TEST_F(PromiseGroupTestFixture, SetValues_WrongNumberOfValues_Throws)
+{
+    azul::async::PromiseGroup<int> group(3);
+
+    ASSERT_THROW(group.SetValues(std::vector<int>{ 1, 2 }), std::invalid_argument);
+}
+
+TEST_F(PromiseGroupTestFixture, SetValues_ContinuationsRunAfterAllValuesPublished)
+{
+    azul::async::PromiseGroup<int> group(3);
+    auto futures = group.GetFutures();
+
+    std::vector<bool> allReadyWhenContinued;
+    for (auto& future : futures)
+    {
+        future.Then([&futures, &allReadyWhenContinued](azul::async::Future<int>) {
+            allReadyWhenContinued.push_back(futures[0].IsReady() && futures[1].IsReady() && futures[2].IsReady());
+        });
+    }
+
+    group.SetValues(std::vector<int>{ 1, 2, 3 });
+
+    ASSERT_EQ(std::vector<bool>({ true, true, true }), allReadyWhenContinued);
+}
+
+TEST_F(PromiseGroupTestFixture, SetValues_Executor_ContinuationsSubmittedAsOneTask)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+
+    std::atomic<int> posts{ 0 };
+    class CountingExecutor final : public azul::async::Executor
+    {
+    public:
+        CountingExecutor(std::shared_ptr<azul::async::Executor> const& inner, std::atomic<int>& posts)
+            : _inner(inner)
+            , _posts(posts)
+        {
+
+        }
+
+        void Post(std::function<void()> task) override
+        {
+            ++_posts;
+            _inner->Post(std::move(task));
+        }
+
+        std::size_t Concurrency() const noexcept override
+        {
+            return _inner->Concurrency();
+        }
+
+    private:
+        std::shared_ptr<azul::async::Executor> _inner;
+        std::atomic<int>& _posts;
+    };
+
+    azul::async::PromiseGroup<int> group(16, std::make_shared<CountingExecutor>(azul::async::MakeExecutor(threadPool), posts));
+    std::vector<azul::async::Future<int>> results;
+    for (auto& future : group.GetFutures())
+    {
+        results.emplace_back(future.Then([](azul::async::Future<int> value) { return value.Get() * 2; }));
+    }
+
+    group.SetValues(std::vector<int>(16, 21));
+
+    for (auto& result : results)
+    {
+        ASSERT_EQ(42, result.Get());
+    }
+    ASSERT_EQ(1, posts.load());
+}
+
+TEST_F(PromiseGroupTestFixture, SetValues_BlockedWaiters_AllWoken)
+{
+    azul::async::PromiseGroup<int> group(4);
+    auto futures = group.GetFutures();
+
+    std::atomic<int> sum{ 0 };
+    std::vector<std::thread> waiters;
+    for (auto& future : futures)
+    {
+        waiters.emplace_back([future, &sum]() { sum += future.Get(); });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    group.SetValues(std::vector<int>{ 1, 2, 3, 4 });
+
+    for (auto& waiter : waiters)
+    {
+        waiter.join();
+    }
+    ASSERT_EQ(10, sum.load());
+}
+
+TEST_F(PromiseGroupTestFixture, SetValue_Individually_OthersStillPendingAndSkippedByBulk)
+{
+    azul::async::PromiseGroup<int> group(2);
+    auto futures = group.GetFutures();
+
+    group.SetValue(0, 7);
+    ASSERT_TRUE(futures[0].IsReady());
+    ASSERT_FALSE(futures[1].IsReady());
+
+    group.SetValues(std::vector<int>{ 1, 2 });
+
+    ASSERT_EQ(7, futures[0].Get());
+    ASSERT_EQ(2, futures[1].Get());
+    ASSERT_THROW(group.SetValue(1, 3), azul::async::FutureError);
+}
+
+TEST_F(PromiseGroupTestFixture, SetExceptions_PendingPromises_ExceptionForwarded)
+{
+    azul::async::PromiseGroup<void> group(2);
+    auto futures = group.GetFutures();
+
+    group.SetValue(0);
+    group.SetExceptions(std::make_exception_ptr(std::runtime_error("")));
+
+    ASSERT_NO_THROW(futures[0].Get());
+    ASSERT_THROW(futures[1].Get(), std::runtime_error);
+}
+
+TEST_F(PromiseGroupTestFixture, Add_GroupGrows_NewPromiseCompletedByBulk)
+{
+    azul::async::PromiseGroup<void> group;
+    auto first = group.Add();
+    auto second = group.Add();
+
+    ASSERT_EQ(2u, group.Size());
+    group.SetValues();
+
+    ASSERT_NO_THROW(first.Get());
+    ASSERT_NO_THROW(second.Get());
+}
+
+TEST_F(PromiseGroupTestFixture, Destructor_PendingPromises_BrokenPromise)
+{
+    azul::async::Future<int> future;
+    {
+        azul::async::PromiseGroup<int> group(1);
+        future = group.GetFuture(0);
+    }
+
+    ASSERT_THROW(future.Get(), azul::async::FutureError);
+}
+
+TEST_F(PromiseGroupTestFixture, MoveAssignment_PreviousPromisesBroken)
+{
+    azul::async::PromiseGroup<int> group(1);
+    auto future = group.GetFuture(0);
+
+    group = azul::async::PromiseGroup<int>(2);
+
+    ASSERT_THROW(future.Get(), azul::async::FutureError);
+    ASSERT_EQ(2u, group.Size());
+}
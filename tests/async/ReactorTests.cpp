@@ -0,0 +1,247 @@
+#if defined(__linux__)
+
+#include <array>
+#include <gmock/gmock.h>
+#include <azul/async/Reactor.hpp>
+#include <azul/async/StaticThreadPool.hpp>
+#include <cstring>
+#include <string>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+class ReactorTestFixture : public testing::Test
+{
+};
+
+namespace
+{
+    // closes the descriptors at the end of the test
+    struct SocketPair
+    {
+        SocketPair()
+        {
+            ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data());
+        }
+
+        ~SocketPair()
+        {
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+
+        std::array<int, 2> fds{ -1, -1 };
+    };
+}
+
+TEST_F(ReactorTestFixture, Read_DataAlreadyAvailable_CompletesWithBytesRead)
+{
+    SocketPair sockets;
+    azul::async::Reactor reactor;
+    reactor.Register(sockets.fds[0]);
+
+    ASSERT_EQ(5, ::write(sockets.fds[1], "hello", 5));
+
+    std::array<char, 16> buffer{ };
+    auto bytesRead = reactor.Read(sockets.fds[0], buffer.data(), buffer.size());
+
+    ASSERT_EQ(5u, bytesRead.Get());
+    ASSERT_EQ(std::string("hello"), std::string(buffer.data(), 5));
+}
+
+TEST_F(ReactorTestFixture, Read_DataArrivesLater_CompletesOnceReadable)
+{
+    SocketPair sockets;
+    azul::async::Reactor reactor;
+    reactor.Register(sockets.fds[0]);
+
+    std::array<char, 16> buffer{ };
+    auto bytesRead = reactor.Read(sockets.fds[0], buffer.data(), buffer.size());
+    ASSERT_FALSE(bytesRead.WaitFor(std::chrono::milliseconds(20)));
+
+    ASSERT_EQ(3, ::write(sockets.fds[1], "abc", 3));
+
+    ASSERT_EQ(3u, bytesRead.Get());
+    ASSERT_EQ(std::string("abc"), std::string(buffer.data(), 3));
+}
+
+TEST_F(ReactorTestFixture, Read_MultipleReadsPending_CompletedInSubmissionOrder)
+{
+    SocketPair sockets;
+    azul::async::Reactor reactor;
+    reactor.Register(sockets.fds[0]);
+
+    std::array<char, 2> first{ };
+    std::array<char, 2> second{ };
+    auto firstRead = reactor.Read(sockets.fds[0], first.data(), first.size());
+    auto secondRead = reactor.Read(sockets.fds[0], second.data(), second.size());
+
+    ASSERT_EQ(4, ::write(sockets.fds[1], "abcd", 4));
+
+    ASSERT_EQ(2u, firstRead.Get());
+    ASSERT_EQ(2u, secondRead.Get());
+    ASSERT_EQ(std::string("ab"), std::string(first.data(), 2));
+    ASSERT_EQ(std::string("cd"), std::string(second.data(), 2));
+}
+
+TEST_F(ReactorTestFixture, Read_PeerClosed_ZeroBytesRead)
+{
+    SocketPair sockets;
+    azul::async::Reactor reactor;
+    reactor.Register(sockets.fds[0]);
+
+    std::array<char, 16> buffer{ };
+    auto bytesRead = reactor.Read(sockets.fds[0], buffer.data(), buffer.size());
+    ::shutdown(sockets.fds[1], SHUT_WR);
+
+    ASSERT_EQ(0u, bytesRead.Get());
+}
+
+TEST_F(ReactorTestFixture, Write_LargerThanSocketBuffer_AllBytesWritten)
+{
+    SocketPair sockets;
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    azul::async::Reactor reactor(threadPool);
+    reactor.Register(sockets.fds[0]);
+    reactor.Register(sockets.fds[1]);
+
+    std::vector<char> data(4 * 1024 * 1024);
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<char>(i % 251);
+    }
+
+    auto bytesWritten = reactor.Write(sockets.fds[0], data.data(), data.size());
+
+    std::vector<char> received;
+    std::array<char, 64 * 1024> buffer{ };
+    while (received.size() < data.size())
+    {
+        auto const bytesRead = reactor.Read(sockets.fds[1], buffer.data(), buffer.size()).Get();
+        ASSERT_GT(bytesRead, 0u);
+        received.insert(received.end(), buffer.data(), buffer.data() + bytesRead);
+    }
+
+    ASSERT_EQ(data.size(), bytesWritten.Get());
+    ASSERT_TRUE(data == received);
+}
+
+TEST_F(ReactorTestFixture, Write_PeerClosed_SystemErrorInsteadOfSignal)
+{
+    SocketPair sockets;
+    azul::async::Reactor reactor;
+    reactor.Register(sockets.fds[0]);
+    ::close(sockets.fds[1]);
+    sockets.fds[1] = -1;
+
+    auto bytesWritten = reactor.Write(sockets.fds[0], "x", 1);
+
+    ASSERT_THROW(bytesWritten.Get(), std::system_error);
+}
+
+TEST_F(ReactorTestFixture, WaitReadable_DataWritten_Ready)
+{
+    std::array<int, 2> fds{ };
+    ASSERT_EQ(0, ::pipe(fds.data()));
+    azul::async::Reactor reactor;
+    reactor.Register(fds[0]);
+
+    auto readable = reactor.WaitReadable(fds[0]);
+    ASSERT_FALSE(readable.WaitFor(std::chrono::milliseconds(20)));
+
+    ASSERT_EQ(1, ::write(fds[1], "x", 1));
+    readable.Get();
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_F(ReactorTestFixture, WaitWritable_EmptyPipe_Ready)
+{
+    std::array<int, 2> fds{ };
+    ASSERT_EQ(0, ::pipe(fds.data()));
+    azul::async::Reactor reactor;
+    reactor.Register(fds[1]);
+
+    reactor.WaitWritable(fds[1]).Get();
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_F(ReactorTestFixture, Unregister_ReadPending_OperationCanceled)
+{
+    SocketPair sockets;
+    azul::async::Reactor reactor;
+    reactor.Register(sockets.fds[0]);
+
+    std::array<char, 16> buffer{ };
+    auto bytesRead = reactor.Read(sockets.fds[0], buffer.data(), buffer.size());
+    reactor.Unregister(sockets.fds[0]);
+
+    ASSERT_THROW(bytesRead.Get(), std::system_error);
+    ASSERT_EQ(0u, reactor.NumberOfDescriptors());
+}
+
+TEST_F(ReactorTestFixture, Destructor_ReadPending_BrokenPromise)
+{
+    SocketPair sockets;
+    std::array<char, 16> buffer{ };
+    azul::async::Future<std::size_t> bytesRead;
+    {
+        azul::async::Reactor reactor;
+        reactor.Register(sockets.fds[0]);
+        bytesRead = reactor.Read(sockets.fds[0], buffer.data(), buffer.size());
+    }
+
+    ASSERT_THROW(bytesRead.Get(), azul::async::FutureError);
+}
+
+TEST_F(ReactorTestFixture, Read_UnregisteredDescriptor_Throws)
+{
+    azul::async::Reactor reactor;
+    std::array<char, 16> buffer{ };
+
+    ASSERT_THROW(reactor.Read(42, buffer.data(), buffer.size()), std::logic_error);
+}
+
+TEST_F(ReactorTestFixture, Register_Twice_Throws)
+{
+    SocketPair sockets;
+    azul::async::Reactor reactor;
+    reactor.Register(sockets.fds[0]);
+
+    ASSERT_THROW(reactor.Register(sockets.fds[0]), std::logic_error);
+}
+
+TEST_F(ReactorTestFixture, Read_ManyConnections_AllCompletedByOneReactorThread)
+{
+    const std::size_t connections = 500;
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    azul::async::Reactor reactor(threadPool);
+
+    std::vector<std::unique_ptr<SocketPair>> sockets;
+    std::vector<std::array<char, 8>> buffers(connections);
+    std::vector<azul::async::Future<std::size_t>> reads;
+    for (std::size_t i = 0; i < connections; ++i)
+    {
+        sockets.emplace_back(std::make_unique<SocketPair>());
+        reactor.Register(sockets.back()->fds[0]);
+        reads.emplace_back(reactor.Read(sockets.back()->fds[0], buffers[i].data(), buffers[i].size()));
+    }
+
+    for (std::size_t i = 0; i < connections; ++i)
+    {
+        auto const message = std::to_string(i);
+        ASSERT_EQ(static_cast<ssize_t>(message.size()), ::write(sockets[i]->fds[1], message.data(), message.size()));
+    }
+
+    for (std::size_t i = 0; i < connections; ++i)
+    {
+        auto const bytesRead = reads[i].Get();
+        ASSERT_EQ(std::to_string(i), std::string(buffers[i].data(), bytesRead));
+    }
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <gmock/gmock.h>
+#include <azul/async/ShardedRuntime.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+class ShardedRuntimeTestFixture : public testing::Test
+{
+protected:
+    static azul::async::ShardedRuntimeOptions Options(std::size_t const shards)
+    {
+        azul::async::ShardedRuntimeOptions options;
+        options.shards = shards;
+        options.pinThreads = false;
+        options.idleSpinsBeforeYield = 16;
+        return options;
+    }
+};
+
+TEST_F(ShardedRuntimeTestFixture, SubmitTo_FromExternalThread_ExecutedOnShard)
+{
+    azul::async::ShardedRuntime runtime(Options(2));
+
+    auto shard = runtime.SubmitTo(1, []() { return azul::async::ShardedRuntime::CurrentShard(); });
+
+    ASSERT_EQ(1u, shard.Get());
+    ASSERT_EQ(2u, runtime.ShardCount());
+    ASSERT_FALSE(azul::async::ShardedRuntime::RunningOnShard());
+}
+
+TEST_F(ShardedRuntimeTestFixture, SubmitTo_TaskThrowsException_ExceptionForwarded)
+{
+    azul::async::ShardedRuntime runtime(Options(1));
+
+    auto result = runtime.SubmitTo(0, []() { throw std::invalid_argument(""); });
+
+    ASSERT_THROW(result.Get(), std::invalid_argument);
+}
+
+TEST_F(ShardedRuntimeTestFixture, SubmitTo_InvalidShard_ThrowsOutOfRange)
+{
+    azul::async::ShardedRuntime runtime(Options(1));
+
+    ASSERT_THROW(runtime.SubmitTo(1, []() { }), std::out_of_range);
+}
+
+TEST_F(ShardedRuntimeTestFixture, SubmitTo_FromOtherShard_ResultCompletedOnSubmittingShard)
+{
+    azul::async::ShardedRuntime runtime(Options(2));
+
+    auto result = runtime.SubmitTo(0, [&runtime]() {
+        return runtime.SubmitTo(1, []() { return azul::async::ShardedRuntime::CurrentShard(); })
+            .Then([](azul::async::Future<std::size_t> f) { return std::make_pair(f.Get(), azul::async::ShardedRuntime::CurrentShard()); });
+    });
+
+    auto const shards = result.Get().Get();
+    ASSERT_EQ(1u, shards.first);
+    ASSERT_EQ(0u, shards.second);
+}
+
+TEST_F(ShardedRuntimeTestFixture, SubmitTo_ManyMessagesBetweenShards_ProcessedInOrder)
+{
+    auto options = Options(2);
+    // forces most messages through the overflow list of the sending shard
+    options.queueCapacity = 4;
+    azul::async::ShardedRuntime runtime(options);
+
+    // only accessed by shard 1, no synchronization required
+    std::vector<int> received;
+
+    auto sent = runtime.SubmitTo(0, [&runtime, &received]() {
+        azul::async::Future<void> last;
+        for (int i = 0; i < 1000; ++i)
+        {
+            last = runtime.SubmitTo(1, [&received, i]() { received.push_back(i); });
+        }
+        return last;
+    });
+
+    sent.Get().Get();
+    auto const ordered = runtime.SubmitTo(1, [&received]() {
+        for (std::size_t i = 0; i < received.size(); ++i)
+        {
+            if (received[i] != static_cast<int>(i))
+            {
+                return false;
+            }
+        }
+        return received.size() == 1000u;
+    });
+    ASSERT_TRUE(ordered.Get());
+}
+
+TEST_F(ShardedRuntimeTestFixture, SubmitAfter_Delay_ExecutedAfterDelayOnShard)
+{
+    azul::async::ShardedRuntime runtime(Options(2));
+    auto const start = std::chrono::steady_clock::now();
+
+    auto shard = runtime.SubmitAfter(1, std::chrono::milliseconds(20), []() { return azul::async::ShardedRuntime::CurrentShard(); });
+
+    ASSERT_EQ(1u, shard.Get());
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST_F(ShardedRuntimeTestFixture, LocalMemoryResource_OnShard_ArenaOfShard)
+{
+    azul::async::ShardedRuntime runtime(Options(2));
+
+    auto first = runtime.SubmitTo(0, []() { return azul::async::ShardedRuntime::LocalMemoryResource(); }).Get();
+    auto second = runtime.SubmitTo(1, []() { return azul::async::ShardedRuntime::LocalMemoryResource(); }).Get();
+
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(first, second);
+    ASSERT_THROW(azul::async::ShardedRuntime::LocalMemoryResource(), std::logic_error);
+}
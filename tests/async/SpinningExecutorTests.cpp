@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/SpinningExecutor.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class SpinningExecutorTestFixture : public testing::Test
+{
+};
+
+TEST_F(SpinningExecutorTestFixture, Execute_TaskReturningValue_ResultForwarded)
+{
+    azul::async::SpinningExecutor executor(1);
+
+    ASSERT_EQ(42, executor.Execute([]() { return 42; }).Get());
+}
+
+TEST_F(SpinningExecutorTestFixture, Execute_TaskThrowsException_ExceptionForwarded)
+{
+    azul::async::SpinningExecutor executor(1);
+
+    auto result = executor.Execute([]() { throw std::invalid_argument(""); });
+
+    ASSERT_THROW(result.Get(), std::invalid_argument);
+}
+
+TEST_F(SpinningExecutorTestFixture, Execute_TaskWithDependency_ExecutedAfterDependency)
+{
+    azul::async::SpinningExecutor executor(1);
+    azul::async::Promise<void> promise;
+    std::atomic<bool> executed{ false };
+
+    auto result = executor.Execute([&executed]() { executed = true; }, promise.GetFuture());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_FALSE(executed.load());
+
+    promise.SetValue();
+    result.Get();
+    ASSERT_TRUE(executed.load());
+}
+
+TEST_F(SpinningExecutorTestFixture, Execute_BlockedTaskBetweenReadyTasks_ReadyTasksNotDelayed)
+{
+    azul::async::SpinningExecutor executor(1);
+    azul::async::Promise<void> promise;
+    std::atomic<bool> executed{ false };
+
+    auto blocked = executor.Execute([&executed]() { executed = true; }, promise.GetFuture());
+
+    std::vector<azul::async::Future<int>> results;
+    for (int i = 0; i < 1000; ++i)
+    {
+        results.push_back(executor.Execute([i]() { return i; }));
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(i, results[i].Get());
+    }
+    ASSERT_FALSE(executed.load());
+
+    promise.SetValue();
+    blocked.Get();
+    ASSERT_TRUE(executed.load());
+}
+
+TEST_F(SpinningExecutorTestFixture, Execute_ManyProducers_AllTasksExecuted)
+{
+    azul::async::SpinningExecutor executor(2);
+    std::atomic<int> counter{ 0 };
+    std::vector<std::thread> producers;
+    std::vector<azul::async::Future<void>> futures(4000);
+
+    for (int p = 0; p < 4; ++p)
+    {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < 1000; ++i)
+            {
+                futures[p * 1000 + i] = executor.Execute([&counter]() { ++counter; });
+            }
+        });
+    }
+    std::for_each(producers.begin(), producers.end(), [](auto& t) { t.join(); });
+    std::for_each(futures.begin(), futures.end(), [](auto f) { f.Get(); });
+
+    ASSERT_EQ(4000, counter.load());
+}
+
+TEST_F(SpinningExecutorTestFixture, Constructor_CpusGiven_ThreadsPinned)
+{
+    azul::async::SpinningExecutorOptions options;
+    options.cpus = { 0 };
+    azul::async::SpinningExecutor executor(1, options);
+
+#if defined(__linux__)
+    ASSERT_EQ(0, executor.Execute([]() { return sched_getcpu(); }).Get());
+#else
+    ASSERT_EQ(1u, executor.ThreadCount());
+#endif
+}
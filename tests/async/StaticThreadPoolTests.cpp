@@ -1,3 +1,4 @@
+#include <atomic>
 #include <gmock/gmock.h>
 #include <azul/async/StaticThreadPool.hpp>
 #include <thread>
@@ -141,3 +142,192 @@ TEST_F(StaticThreadPoolTestFixture, Execute_MultipleTasksNoDependencies_AllThrea
     ASSERT_EQ(utlizedThreadIds.size(), executor.ThreadCount());
 }
 
+
+namespace
+{
+    // occupies the only worker of the thread pool until the returned promise is set
+    azul::async::Promise<void> BlockWorker(azul::async::StaticThreadPool& executor)
+    {
+        azul::async::Promise<void> gate;
+        std::atomic<bool> started{ false };
+
+        executor.Execute([gateFuture = gate.GetFuture(), &started](){
+            started = true;
+            gateFuture.Wait();
+        });
+
+        while (!started)
+        {
+            std::this_thread::yield();
+        }
+
+        return gate;
+    }
+}
+
+TEST_F(StaticThreadPoolTestFixture, Execute_QueueFullRejectPolicy_FutureHoldsQueueFullError)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::Reject;
+    azul::async::StaticThreadPool executor(1, options);
+
+    auto gate = BlockWorker(executor);
+    auto queued = executor.Execute([](){ return 1; });
+    auto rejected = executor.Execute([](){ return 2; });
+
+    ASSERT_TRUE(rejected.IsReady());
+    try
+    {
+        rejected.Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::QueueFull, error.ErrorCode());
+    }
+
+    gate.SetValue();
+    ASSERT_EQ(1, queued.Get());
+    ASSERT_EQ(1u, executor.Statistics().rejectedTasks);
+}
+
+TEST_F(StaticThreadPoolTestFixture, Execute_QueueFullCallerRunsPolicy_ExecutedOnCallingThread)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::CallerRuns;
+    azul::async::StaticThreadPool executor(1, options);
+
+    auto gate = BlockWorker(executor);
+    auto queued = executor.Execute([](){ return std::this_thread::get_id(); });
+    auto inlined = executor.Execute([](){ return std::this_thread::get_id(); });
+
+    ASSERT_TRUE(inlined.IsReady());
+    ASSERT_EQ(std::this_thread::get_id(), inlined.Get());
+
+    gate.SetValue();
+    ASSERT_NE(std::this_thread::get_id(), queued.Get());
+}
+
+TEST_F(StaticThreadPoolTestFixture, Execute_QueueFullDropOldestPolicy_OldestTaskDropped)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::DropOldest;
+    azul::async::StaticThreadPool executor(1, options);
+
+    auto gate = BlockWorker(executor);
+    auto oldest = executor.Execute([](){ return 1; });
+    auto newest = executor.Execute([](){ return 2; });
+
+    ASSERT_THROW(oldest.Get(), azul::async::FutureError);
+
+    gate.SetValue();
+    ASSERT_EQ(2, newest.Get());
+    ASSERT_EQ(1u, executor.Statistics().droppedTasks);
+}
+
+TEST_F(StaticThreadPoolTestFixture, Execute_QueueFullBlockPolicy_BlocksUntilSpaceAvailable)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::Block;
+    azul::async::StaticThreadPool executor(1, options);
+
+    auto gate = BlockWorker(executor);
+    auto queued = executor.Execute([](){ return 1; });
+
+    std::atomic<bool> submitted{ false };
+    std::thread producer([&](){
+        executor.Execute([](){ return 2; }).Get();
+        submitted = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(submitted);
+
+    gate.SetValue();
+    producer.join();
+
+    ASSERT_TRUE(submitted);
+    ASSERT_EQ(1, queued.Get());
+    ASSERT_EQ(1u, executor.Statistics().blockedSubmissions);
+}
+
+TEST_F(StaticThreadPoolTestFixture, Execute_QueueFullBlockPolicySubmittedByWorker_ExecutedByWorker)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::Block;
+    azul::async::StaticThreadPool executor(1, options);
+
+    auto inner = executor.Execute([&executor]() {
+        std::vector<azul::async::Future<std::thread::id>> futures;
+        for (int i = 0; i < 3; ++i)
+        {
+            futures.push_back(executor.Execute([](){ return std::this_thread::get_id(); }));
+        }
+        return futures;
+    }).Get();
+
+    for (auto& future : inner)
+    {
+        ASSERT_NE(std::this_thread::get_id(), future.Get());
+    }
+    ASSERT_EQ(0u, executor.Statistics().blockedSubmissions);
+    ASSERT_EQ(2u, executor.Statistics().callerRunsTasks);
+}
+
+TEST_F(StaticThreadPoolTestFixture, Execute_QueueFullBlockPolicyPendingDependencySubmittedByWorker_EnqueuedBeyondCapacity)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::Block;
+    azul::async::StaticThreadPool executor(1, options);
+    azul::async::Promise<void> dependency;
+
+    // the dependency is completed by the queued task, waiting for it on the only worker would never return
+    auto dependent = executor.Execute([&executor, &dependency]() {
+        executor.Execute([&dependency]() { dependency.SetValue(); });
+        return executor.Execute([](){ return 42; }, dependency.GetFuture());
+    }).Get();
+
+    ASSERT_EQ(42, dependent.Get());
+    ASSERT_EQ(0u, executor.Statistics().callerRunsTasks);
+    ASSERT_EQ(2u, executor.Statistics().peakDepth);
+}
+
+TEST_F(StaticThreadPoolTestFixture, Destructor_LastReferenceReleasedByTask_WorkerDetached)
+{
+    auto executor = std::make_shared<azul::async::StaticThreadPool>(2);
+    std::weak_ptr<azul::async::StaticThreadPool> weakExecutor = executor;
+    azul::async::Promise<void> gate;
+
+    auto done = executor->Execute([gateFuture = gate.GetFuture(), executor]() {
+        gateFuture.Wait();
+    });
+    executor.reset();
+    gate.SetValue();
+
+    done.Get();
+    ASSERT_TRUE(weakExecutor.expired());
+}
+
+TEST_F(StaticThreadPoolTestFixture, Statistics_TasksQueued_DepthReported)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 8;
+    azul::async::StaticThreadPool executor(1, options);
+
+    auto gate = BlockWorker(executor);
+    executor.Execute([](){});
+    executor.Execute([](){});
+
+    const auto statistics = executor.Statistics();
+    ASSERT_EQ(2u, statistics.depth);
+    ASSERT_EQ(2u, executor.QueueDepth());
+    ASSERT_EQ(8u, statistics.capacity);
+
+    gate.SetValue();
+}
@@ -0,0 +1,139 @@
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/Strand.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class StrandTestFixture : public testing::Test
+{
+};
+
+TEST_F(StrandTestFixture, Execute_TaskReturningValue_ResultForwarded)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    azul::async::Strand<azul::async::StaticThreadPool> strand(threadPool);
+
+    auto result = strand.Execute([](){ return 42; });
+
+    ASSERT_EQ(42, result.Get());
+}
+
+TEST_F(StrandTestFixture, Execute_TaskThrowsException_ExceptionForwarded)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    azul::async::Strand<azul::async::StaticThreadPool> strand(threadPool);
+
+    auto result = strand.Execute([](){ throw std::invalid_argument(""); });
+
+    ASSERT_THROW(result.Get(), std::invalid_argument);
+}
+
+TEST_F(StrandTestFixture, Execute_MultipleTasks_ExecutedInSubmissionOrder)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(4);
+    azul::async::Strand<azul::async::StaticThreadPool> strand(threadPool, 4);
+
+    const int tasksToExecute = 200;
+    std::vector<int> ids;
+    std::vector<azul::async::Future<void>> futures;
+
+    for (int i = 0; i < tasksToExecute; ++i)
+    {
+        futures.emplace_back(strand.Execute([i, &ids](){ ids.push_back(i); }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto f){ f.Wait(); });
+
+    ASSERT_EQ(static_cast<std::size_t>(tasksToExecute), ids.size());
+    for (int i = 0; i < tasksToExecute; ++i)
+    {
+        ASSERT_EQ(i, ids[i]);
+    }
+}
+
+TEST_F(StrandTestFixture, Execute_ConcurrentProducers_NeverExecutedConcurrently)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(4);
+    azul::async::Strand<azul::async::StaticThreadPool> strand(threadPool);
+
+    std::atomic<int> activeTasks{ 0 };
+    std::atomic<bool> overlapDetected{ false };
+    int counter = 0;
+
+    auto action = [&]() {
+        if (activeTasks.fetch_add(1) != 0)
+        {
+            overlapDetected = true;
+        }
+        ++counter;
+        activeTasks.fetch_sub(1);
+    };
+
+    const int tasksPerProducer = 250;
+    std::vector<std::thread> producers;
+    std::vector<azul::async::Future<void>> futures[4];
+
+    for (int p = 0; p < 4; ++p)
+    {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < tasksPerProducer; ++i)
+            {
+                futures[p].emplace_back(strand.Execute(action));
+            }
+        });
+    }
+    std::for_each(producers.begin(), producers.end(), [](auto& t){ t.join(); });
+
+    for (auto& producerFutures : futures)
+    {
+        std::for_each(producerFutures.begin(), producerFutures.end(), [](auto f){ f.Wait(); });
+    }
+
+    ASSERT_FALSE(overlapDetected);
+    ASSERT_EQ(4 * tasksPerProducer, counter);
+}
+
+TEST_F(StrandTestFixture, RunningInThisThread_CalledFromStrandTask_ReturnsTrue)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1);
+    azul::async::Strand<azul::async::StaticThreadPool> strand(threadPool);
+
+    auto result = strand.Execute([&strand](){ return strand.RunningInThisThread(); });
+
+    ASSERT_TRUE(result.Get());
+    ASSERT_FALSE(strand.RunningInThisThread());
+}
+
+TEST_F(StrandTestFixture, Execute_BoundedPoolDropsDrain_TaskFailedAndStrandNotStuck)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::DropOldest;
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1, options);
+    azul::async::Strand<azul::async::StaticThreadPool> strand(threadPool);
+
+    azul::async::Promise<void> gate;
+    auto running = std::make_shared<azul::async::Promise<void>>();
+    auto blocker = threadPool->Execute([&gate, running]() { running->SetValue(); gate.GetFuture().Wait(); });
+    running->GetFuture().Wait();
+
+    auto dropped = strand.Execute([]() { return 1; });
+    auto displacing = threadPool->Execute([]() {});
+
+    try
+    {
+        dropped.Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::BrokenPromise, error.ErrorCode());
+    }
+
+    gate.SetValue();
+    blocker.Wait();
+    displacing.Wait();
+
+    ASSERT_EQ(42, strand.Execute([]() { return 42; }).Get());
+}
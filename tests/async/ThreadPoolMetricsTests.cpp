@@ -0,0 +1,142 @@
+#include <gmock/gmock.h>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/ThreadPoolMetrics.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+class ThreadPoolMetricsTestFixture : public testing::Test
+{
+};
+
+TEST_F(ThreadPoolMetricsTestFixture, Metrics_TasksQueued_QueueDepthReported)
+{
+    azul::async::StaticThreadPool threadPool(1);
+    azul::async::Promise<void> gate;
+
+    auto blocker = threadPool.Execute([]() {}, gate.GetFuture());
+    auto queued = threadPool.Execute([]() {}, gate.GetFuture());
+
+    ASSERT_EQ(2u, threadPool.Metrics().queueDepth);
+
+    gate.SetValue();
+    blocker.Wait();
+    queued.Wait();
+}
+
+#if defined(LIBAZUL_WITH_ASYNC_METRICS)
+
+TEST_F(ThreadPoolMetricsTestFixture, Metrics_TasksExecuted_TimingsRecorded)
+{
+    azul::async::StaticThreadPool threadPool(2);
+
+    std::vector<azul::async::Future<void>> futures;
+    for (int i = 0; i < 20; ++i)
+    {
+        futures.emplace_back(threadPool.Execute([]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }));
+    }
+    for (auto& future : futures)
+    {
+        future.Wait();
+    }
+
+    // the worker accounts a task after its promise has been completed
+    auto metrics = threadPool.Metrics();
+    for (int i = 0; i < 100 && metrics.executedTasks < 20; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        metrics = threadPool.Metrics();
+    }
+
+    ASSERT_TRUE(metrics.enabled);
+    ASSERT_EQ(20u, metrics.submittedTasks);
+    ASSERT_EQ(20u, metrics.executedTasks);
+    ASSERT_EQ(20u, metrics.waitTime.count);
+    ASSERT_EQ(20u, metrics.runTime.count);
+    ASSERT_EQ(20u, metrics.queueDepthOnSubmit.count);
+    ASSERT_GE(metrics.runTime.min, 1000000u);
+    ASSERT_GE(metrics.queueDepthOnSubmit.max, 1u);
+
+    ASSERT_EQ(2u, metrics.workers.size());
+    std::uint64_t executed = 0;
+    std::uint64_t busyTime = 0;
+    for (auto const& worker : metrics.workers)
+    {
+        executed += worker.executedTasks;
+        busyTime += worker.busyTime;
+        ASSERT_GE(worker.Utilization(), 0.0);
+        ASSERT_LE(worker.Utilization(), 1.0);
+    }
+    ASSERT_EQ(20u, executed);
+    ASSERT_EQ(metrics.runTime.sum, busyTime);
+}
+
+TEST_F(ThreadPoolMetricsTestFixture, Metrics_TaskWaitsForDependency_DependencyExcludedFromWaitTimeAndQueueDepth)
+{
+    azul::async::StaticThreadPool threadPool(1);
+    azul::async::Promise<void> gate;
+
+    auto future = threadPool.Execute([]() {}, gate.GetFuture());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // completed on the worker, which then finds the dependent task runnable without parking in between
+    threadPool.Execute([&gate]() { gate.SetValue(); }).Wait();
+    future.Wait();
+
+    auto metrics = threadPool.Metrics();
+    for (int i = 0; i < 100 && metrics.executedTasks < 2; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        metrics = threadPool.Metrics();
+    }
+
+    ASSERT_EQ(2u, metrics.waitTime.count);
+    ASSERT_LT(metrics.waitTime.max, 50000000u);
+    ASSERT_EQ(2u, metrics.queueDepthOnSubmit.count);
+    ASSERT_EQ(0u, metrics.queueDepthOnSubmit.min);
+    ASSERT_EQ(1u, metrics.queueDepthOnSubmit.max);
+}
+
+TEST_F(ThreadPoolMetricsTestFixture, Metrics_NoTasks_WorkersParkAndIdle)
+{
+    azul::async::StaticThreadPool threadPool(1);
+
+    auto metrics = threadPool.Metrics();
+    for (int i = 0; i < 100 && metrics.workers[0].parks == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        metrics = threadPool.Metrics();
+    }
+
+    ASSERT_GE(metrics.workers[0].parks, 1u);
+    ASSERT_EQ(0u, metrics.workers[0].busyTime);
+}
+
+TEST_F(ThreadPoolMetricsTestFixture, Metrics_IdleAcrossParkTimeouts_ParkedOncePerIdlePeriod)
+{
+    azul::async::StaticThreadPool threadPool(1);
+
+    threadPool.Execute([]() {}).Wait();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2500));
+    threadPool.Execute([]() {}).Wait();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    ASSERT_LE(threadPool.Metrics().workers[0].parks, 3u);
+}
+
+#else
+
+TEST_F(ThreadPoolMetricsTestFixture, Metrics_CompiledOut_OnlyQueueDepthReported)
+{
+    azul::async::StaticThreadPool threadPool(1);
+    threadPool.Execute([]() {}).Wait();
+
+    auto const metrics = threadPool.Metrics();
+
+    ASSERT_FALSE(metrics.enabled);
+    ASSERT_EQ(0u, metrics.waitTime.count);
+    ASSERT_TRUE(metrics.workers.empty());
+}
+
+#endif
@@ -0,0 +1,190 @@
+#include <atomic>
+#include <chrono>
+#include <gmock/gmock.h>
+#include <azul/async/TimerService.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class TimerServiceTestFixture : public testing::Test
+{
+};
+
+TEST_F(TimerServiceTestFixture, ExecuteAfter_Delay_NotExecutedBeforeDelay)
+{
+    azul::async::TimerService timerService(std::make_shared<azul::async::StaticThreadPool>(1));
+
+    const auto start = std::chrono::steady_clock::now();
+    auto result = timerService.ExecuteAfter(std::chrono::milliseconds(50), [](){ return std::chrono::steady_clock::now(); });
+
+    ASSERT_GE(result.Get() - start, std::chrono::milliseconds(50));
+}
+
+TEST_F(TimerServiceTestFixture, ExecuteAt_MultipleTimers_ExecutedInExpiryOrder)
+{
+    azul::async::TimerService timerService(std::make_shared<azul::async::StaticThreadPool>(1));
+
+    std::vector<int> ids;
+    const auto now = std::chrono::steady_clock::now();
+
+    auto future3 = timerService.ExecuteAt(now + std::chrono::milliseconds(60), [&ids](){ ids.push_back(3); });
+    auto future1 = timerService.ExecuteAt(now + std::chrono::milliseconds(20), [&ids](){ ids.push_back(1); });
+    auto future2 = timerService.ExecuteAt(now + std::chrono::milliseconds(40), [&ids](){ ids.push_back(2); });
+
+    future3.Wait();
+
+    ASSERT_EQ(std::vector<int>({ 1, 2, 3 }), ids);
+}
+
+TEST_F(TimerServiceTestFixture, ExecuteAfter_ManyTimers_AllExecuted)
+{
+    azul::async::TimerService timerService(std::make_shared<azul::async::StaticThreadPool>(2));
+
+    std::atomic<int> executed{ 0 };
+    std::vector<azul::async::Future<void>> futures;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        futures.emplace_back(timerService.ExecuteAfter(std::chrono::microseconds(97 * i), [&executed](){ ++executed; }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto f){ f.Wait(); });
+
+    ASSERT_EQ(2000, executed);
+    ASSERT_EQ(0u, timerService.PendingTimers());
+}
+
+TEST_F(TimerServiceTestFixture, ExecuteEvery_Cancelled_NoFurtherExecutions)
+{
+    azul::async::TimerService timerService(std::make_shared<azul::async::StaticThreadPool>(1));
+
+    std::atomic<int> executed{ 0 };
+    auto timer = timerService.ExecuteEvery(std::chrono::milliseconds(5), [&executed](){ ++executed; });
+
+    while (executed < 3)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    timer.Cancel();
+    ASSERT_TRUE(timer.Cancelled());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const int executedAfterCancel = executed;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(executedAfterCancel, executed);
+}
+
+TEST_F(TimerServiceTestFixture, WithTimeout_FutureNotReadyInTime_ThrowsTimeoutError)
+{
+    azul::async::TimerService timerService(std::make_shared<azul::async::StaticThreadPool>(1));
+
+    azul::async::Promise<int> promise;
+    auto future = timerService.WithTimeout(promise.GetFuture(), std::chrono::milliseconds(10));
+
+    try
+    {
+        future.Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::Timeout, error.ErrorCode());
+    }
+
+    promise.SetValue(42);
+    ASSERT_THROW(future.Get(), azul::async::FutureError);
+}
+
+TEST_F(TimerServiceTestFixture, WithTimeout_FutureReadyInTime_ResultForwarded)
+{
+    azul::async::TimerService timerService(std::make_shared<azul::async::StaticThreadPool>(1));
+
+    azul::async::Promise<int> promise;
+    auto future = timerService.WithTimeout(promise.GetFuture(), std::chrono::milliseconds(1000));
+
+    promise.SetValue(42);
+
+    ASSERT_EQ(42, future.Get());
+    ASSERT_EQ(0u, timerService.PendingTimers());
+}
+
+TEST_F(TimerServiceTestFixture, WithTimeout_FutureHoldsException_ExceptionForwarded)
+{
+    azul::async::TimerService timerService(std::make_shared<azul::async::StaticThreadPool>(1));
+
+    azul::async::Promise<void> promise;
+    auto future = timerService.WithTimeout(promise.GetFuture(), std::chrono::milliseconds(1000));
+
+    promise.SetException(std::make_exception_ptr(std::invalid_argument("")));
+
+    ASSERT_THROW(future.Get(), std::invalid_argument);
+}
+
+TEST_F(TimerServiceTestFixture, Destructor_PendingTimer_FutureReportsBrokenPromise)
+{
+    azul::async::Future<void> future;
+    {
+        azul::async::TimerService timerService(std::make_shared<azul::async::StaticThreadPool>(1));
+        future = timerService.ExecuteAfter(std::chrono::seconds(60), [](){});
+    }
+
+    ASSERT_THROW(future.Get(), azul::async::FutureError);
+}
+
+TEST_F(TimerServiceTestFixture, ExecuteAfter_BoundedPoolFullWithBlockPolicy_TimerThreadNotBlocked)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::Block;
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1, options);
+    azul::async::TimerService timerService(threadPool);
+
+    azul::async::Promise<void> gate;
+    auto running = std::make_shared<azul::async::Promise<void>>();
+    auto blocker = threadPool->Execute([&gate, running]() { running->SetValue(); gate.GetFuture().Wait(); });
+    running->GetFuture().Wait();
+    auto queued = threadPool->Execute([]() {});
+
+    auto first = timerService.ExecuteAfter(std::chrono::milliseconds(1), [](){ return 1; });
+    auto second = timerService.ExecuteAfter(std::chrono::milliseconds(5), [](){ return 2; });
+
+    // both timers are handed over although the queue is full
+    while (timerService.PendingTimers() > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_FALSE(first.IsReady());
+
+    gate.SetValue();
+    ASSERT_EQ(1, first.Get());
+    ASSERT_EQ(2, second.Get());
+}
+
+TEST_F(TimerServiceTestFixture, ExecuteAfter_BoundedPoolRejects_FutureHoldsQueueFullError)
+{
+    azul::async::StaticThreadPoolOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = azul::async::OverflowPolicy::Reject;
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(1, options);
+    azul::async::TimerService timerService(threadPool);
+
+    azul::async::Promise<void> gate;
+    auto running = std::make_shared<azul::async::Promise<void>>();
+    auto blocker = threadPool->Execute([&gate, running]() { running->SetValue(); gate.GetFuture().Wait(); });
+    running->GetFuture().Wait();
+    auto queued = threadPool->Execute([]() {});
+
+    auto rejected = timerService.ExecuteAfter(std::chrono::milliseconds(1), [](){ return 1; });
+    try
+    {
+        rejected.Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::QueueFull, error.ErrorCode());
+    }
+
+    gate.SetValue();
+}
@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <functional>
+#include <gmock/gmock.h>
+#include <azul/async/detail/TimerWheel.hpp>
+#include <vector>
+
+class TimerWheelTestFixture : public testing::Test
+{
+};
+
+TEST_F(TimerWheelTestFixture, Advance_TimersOnAllLevels_FiredAtExactTick)
+{
+    azul::async::detail::TimerWheel<> wheel(5);
+
+    const std::vector<std::uint64_t> expiryTicks = { 6, 63, 64, 65, 4095, 4096, 4161, 262144, 300001, (1ull << 24) + 17, (1ull << 25) + 3 };
+    std::vector<std::uint64_t> firedAt(expiryTicks.size(), 0);
+
+    for (std::size_t i = 0; i < expiryTicks.size(); ++i)
+    {
+        wheel.Add(expiryTicks[i], [&firedAt, &wheel, i]() { firedAt[i] = wheel.CurrentTick(); });
+    }
+    ASSERT_EQ(expiryTicks.size(), wheel.Size());
+
+    std::vector<std::function<void()>> expired;
+    while (!wheel.Empty())
+    {
+        wheel.Advance(wheel.NextTick(), expired);
+        for (auto& callback : expired)
+        {
+            callback();
+        }
+        expired.clear();
+    }
+
+    ASSERT_EQ(expiryTicks, firedAt);
+}
+
+TEST_F(TimerWheelTestFixture, Add_ExpiryInThePast_FiredOnNextTick)
+{
+    azul::async::detail::TimerWheel<> wheel(100);
+    wheel.Add(10, [](){});
+
+    std::vector<std::function<void()>> expired;
+    wheel.Advance(101, expired);
+
+    ASSERT_EQ(1u, expired.size());
+    ASSERT_TRUE(wheel.Empty());
+}
+
+TEST_F(TimerWheelTestFixture, Advance_BeforeExpiry_NothingFired)
+{
+    azul::async::detail::TimerWheel<> wheel;
+    wheel.Add(1000, [](){});
+
+    std::vector<std::function<void()>> expired;
+    wheel.Advance(999, expired);
+    ASSERT_TRUE(expired.empty());
+
+    wheel.Advance(1000, expired);
+    ASSERT_EQ(1u, expired.size());
+}
+
+TEST_F(TimerWheelTestFixture, Remove_PendingTimersOnAllLevels_NeverFired)
+{
+    azul::async::detail::TimerWheel<> wheel;
+
+    const std::vector<std::uint64_t> expiryTicks = { 3, 70, 5000, 300000, (1ull << 25) + 3 };
+    std::vector<azul::async::detail::TimerWheel<>::Handle> handles;
+    int fired = 0;
+
+    for (auto const expiryTick : expiryTicks)
+    {
+        handles.push_back(wheel.Add(expiryTick, [&fired]() { ++fired; }));
+    }
+    wheel.Add(4, [&fired]() { fired += 100; });
+
+    std::vector<std::function<void()>> removed;
+    for (auto const& handle : handles)
+    {
+        ASSERT_TRUE(wheel.Remove(handle, removed));
+    }
+    ASSERT_FALSE(wheel.Remove(handles.front(), removed));
+    ASSERT_EQ(expiryTicks.size(), removed.size());
+    ASSERT_EQ(1u, wheel.Size());
+
+    std::vector<std::function<void()>> expired;
+    wheel.Advance(1ull << 26, expired);
+    for (auto& callback : expired)
+    {
+        callback();
+    }
+
+    ASSERT_EQ(100, fired);
+    ASSERT_TRUE(wheel.Empty());
+}
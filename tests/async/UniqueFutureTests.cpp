@@ -0,0 +1,189 @@
+#include <atomic>
+#include <gmock/gmock.h>
+#include <azul/async/StaticThreadPool.hpp>
+#include <azul/async/UniqueFuture.hpp>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+class UniqueFutureTestFixture : public testing::Test
+{
+};
+
+TEST_F(UniqueFutureTestFixture, Get_ValueSet_ValueMovedOut)
+{
+    azul::async::UniquePromise<std::unique_ptr<int>> promise;
+    auto future = promise.GetFuture();
+
+    ASSERT_FALSE(future.IsReady());
+    promise.SetValue(std::make_unique<int>(42));
+    ASSERT_TRUE(future.IsReady());
+
+    auto value = future.Get();
+    ASSERT_EQ(42, *value);
+    ASSERT_FALSE(future.Valid());
+}
+
+TEST_F(UniqueFutureTestFixture, Get_ValueSetByOtherThread_WaitsForValue)
+{
+    azul::async::UniquePromise<int> promise;
+    auto future = promise.GetFuture();
+
+    std::thread producer([promise = std::move(promise)]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        promise.SetValue(7);
+    });
+
+    ASSERT_EQ(7, future.Get());
+    producer.join();
+}
+
+TEST_F(UniqueFutureTestFixture, Get_ExceptionSet_ExceptionRethrown)
+{
+    azul::async::UniquePromise<void> promise;
+    auto future = promise.GetFuture();
+
+    promise.SetException(std::make_exception_ptr(std::invalid_argument("")));
+
+    ASSERT_THROW(future.Get(), std::invalid_argument);
+}
+
+TEST_F(UniqueFutureTestFixture, Get_PromiseDestroyed_BrokenPromise)
+{
+    azul::async::UniqueFuture<int> future;
+    {
+        azul::async::UniquePromise<int> promise;
+        future = promise.GetFuture();
+    }
+
+    try
+    {
+        future.Get();
+        FAIL();
+    }
+    catch (azul::async::FutureError const& error)
+    {
+        ASSERT_EQ(azul::async::FutureErrorCode::BrokenPromise, error.ErrorCode());
+    }
+}
+
+TEST_F(UniqueFutureTestFixture, SetValue_AlreadySet_Throws)
+{
+    azul::async::UniquePromise<int> promise;
+
+    promise.SetValue(1);
+
+    ASSERT_THROW(promise.SetValue(2), azul::async::FutureError);
+}
+
+TEST_F(UniqueFutureTestFixture, GetFuture_CalledTwice_Throws)
+{
+    azul::async::UniquePromise<int> promise;
+
+    auto future = promise.GetFuture();
+
+    ASSERT_THROW(promise.GetFuture(), std::logic_error);
+}
+
+TEST_F(UniqueFutureTestFixture, WaitFor_NoValue_TimesOut)
+{
+    azul::async::UniquePromise<int> promise;
+    auto future = promise.GetFuture();
+
+    ASSERT_FALSE(future.WaitFor(std::chrono::milliseconds(1)));
+
+    promise.SetValue(1);
+    ASSERT_TRUE(future.WaitFor(std::chrono::milliseconds(1)));
+}
+
+TEST_F(UniqueFutureTestFixture, Then_AttachedBeforeValue_ValueMovedIntoContinuation)
+{
+    azul::async::UniquePromise<std::unique_ptr<std::string>> promise;
+
+    auto length = promise.GetFuture().Then([](azul::async::UniqueFuture<std::unique_ptr<std::string>> value) {
+        return value.Get()->size();
+    });
+    ASSERT_FALSE(length.IsReady());
+
+    promise.SetValue(std::make_unique<std::string>("azul"));
+
+    ASSERT_EQ(4u, length.Get());
+}
+
+TEST_F(UniqueFutureTestFixture, Then_AttachedAfterValue_RunsImmediately)
+{
+    azul::async::UniquePromise<int> promise;
+    auto future = promise.GetFuture();
+    promise.SetValue(20);
+
+    auto result = future.Then([capture = std::make_unique<int>(1)](azul::async::UniqueFuture<int> value) {
+        return value.Get() * 2 + *capture;
+    });
+
+    ASSERT_TRUE(result.IsReady());
+    ASSERT_EQ(41, result.Get());
+}
+
+TEST_F(UniqueFutureTestFixture, Then_ContinuationThrows_ExceptionForwarded)
+{
+    azul::async::UniquePromise<int> promise;
+
+    auto result = promise.GetFuture().Then([](azul::async::UniqueFuture<int>) {
+        throw std::runtime_error("");
+    });
+    promise.SetValue(1);
+
+    ASSERT_THROW(result.Get(), std::runtime_error);
+}
+
+TEST_F(UniqueFutureTestFixture, Then_LongChain_NoRecursion)
+{
+    azul::async::UniquePromise<int> promise;
+    auto future = promise.GetFuture();
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        future = future.Then([](azul::async::UniqueFuture<int> value) {
+            return value.Get() + 1;
+        });
+    }
+
+    promise.SetValue(0);
+
+    ASSERT_EQ(100000, future.Get());
+}
+
+TEST_F(UniqueFutureTestFixture, Then_CompletedOnPool_ContinuationsRunOnce)
+{
+    auto threadPool = std::make_shared<azul::async::StaticThreadPool>(2);
+    std::atomic<int> sum{ 0 };
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        azul::async::UniquePromise<int> promise;
+        auto done = promise.GetFuture().Then([&sum](azul::async::UniqueFuture<int> value) {
+            sum += value.Get();
+        });
+
+        threadPool->Execute([promise = std::make_shared<azul::async::UniquePromise<int>>(std::move(promise))]() {
+            promise->SetValue(1);
+        });
+        done.Get();
+    }
+
+    ASSERT_EQ(1000, sum.load());
+}
+
+TEST_F(UniqueFutureTestFixture, Share_ValueSet_SharedFutureCopyable)
+{
+    azul::async::UniquePromise<int> promise;
+    auto shared = promise.GetFuture().Share();
+    auto copy = shared;
+
+    promise.SetValue(3);
+
+    ASSERT_EQ(3, shared.Get());
+    ASSERT_EQ(3, copy.Get());
+}
@@ -1,4 +1,5 @@
 #include <gmock/gmock.h>
+#include <azul/async/Executor.hpp>
 #include <azul/async/StaticThreadPool.hpp>
 #include <azul/compute/clcpp/OpenClComputeExecutor.hpp>
 #include <azul/compute/clcpp/OpenCl.hpp>
@@ -202,3 +203,24 @@ TEST_F(OpenClComputExecutorTestFixture, Execute_WorkItemsWithThreeDims_OffsetCon
     }
 }
 
+
+TEST_F(OpenClComputExecutorTestFixture, Execute_InlineExecutor_AllWorkItemsExecuted)
+{
+    const auto executor = std::make_shared<azul::async::InlineExecutor>();
+    const auto kernel_executor = std::make_shared<azul::compute::clcpp::OpenClComputeExecutor>(executor);
+
+    std::vector<int> result(16, 0);
+
+    const auto kernel = [&result]() {
+        using namespace azul::compute::clcpp;
+        result[get_global_id(1) * 4 + get_global_id(0)]++;
+    };
+
+    auto future = kernel_executor->Execute(kernel, { 4u, 4u });
+    ASSERT_TRUE(future.IsReady());
+
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+        ASSERT_EQ(1, result[i]);
+    }
+}